@@ -1,7 +1,10 @@
 #include "application.h"
 
-#include <curve-x/curve-serializer.h>
-
+#include <src/curve-file.h>
+#include <src/curve-header-exporter.h>
+#include <src/curve-pack.h>
+#include <src/profiler.h>
+#include <src/trace.h>
 #include <src/utils.h>
 #include <src/settings.h>
 
@@ -10,7 +13,8 @@
 using namespace curve_editor_x;
 
 Application::Application( const Rectangle& frame )
-	: _frame( frame )
+	: _frame( frame ),
+	  _importer( settings::IMPORT_THREADS_COUNT )
 {
 }
 
@@ -49,36 +53,62 @@ void Application::init()
 
 void Application::update( float dt )
 {
+	TRACE_SCOPE( "Application::update" );
+
+	_update_imports();
+	_update_saves();
+
 	bool is_shift_down = IsKeyDown( KEY_LEFT_SHIFT );
 	bool is_ctrl_down = IsKeyDown( KEY_LEFT_CONTROL );
 
 	if ( is_ctrl_down )
 	{
 		//  Ctrl+S: Save to current file
-		if ( is_valid_selected_curve() && IsKeyPressed( KEY_S ) )
+		if ( is_valid_selected_curve() && IsKeyPressed( KEY_S ) 
+		  && get_selected_curve_layer()->pack != nullptr && !is_shift_down )
+		{
+			//  Save the changed curves of the pack
+			save_pack( get_selected_curve_layer()->pack );
+		}
+		else if ( is_valid_selected_curve() && IsKeyPressed( KEY_S ) )
 		{
 			const ref<CurveLayer>& layer = get_selected_curve_layer();
 			std::string path = layer->path;
 
+			//  Alt-down: Switch between text & binary formats
+			const CurveFileFormat previous_format = layer->file_format;
+			if ( IsKeyDown( KEY_LEFT_ALT ) )
+			{
+				layer->file_format = 
+					layer->file_format == CurveFileFormat::Text
+						? CurveFileFormat::Binary
+						: CurveFileFormat::Text;
+			}
+
+			const std::string extension = 
+				CurveFile::get_extension( layer->file_format );
+
 			//  Shift-down: Choosing save file location
 			if ( is_shift_down || !layer->is_file_exists )
 			{
 				path = Utils::get_user_save_file(
 					"Curve-X",
-					"Curve-X Files(.cvx)",
-					std::vector<std::string> { FORMAT_EXTENSION }
+					TextFormat( "Curve-X Files(.%s)", extension.c_str() ),
+					std::vector<std::string> { extension }
 				);
+
+				//  Cancelled, the format is left as it was
+				if ( path.length() == 0 )
+				{
+					layer->file_format = previous_format;
+				}
 			}
 
 			//  Save file
 			if ( path.length() > 0 )
 			{
-				//  Force path to hold the format extension
-				path = TextFormat( 
-					"%s.%s",
-					GetFileNameWithoutExt( path.c_str() ),
-					FORMAT_EXTENSION.c_str()
-				);
+				//  Force path to hold the format's extension
+				path = Utils::replace_extension( path, extension );
 				export_to_file( layer, path );
 			}
 		}
@@ -87,22 +117,122 @@ void Application::update( float dt )
 		{
 			auto paths = Utils::get_user_open_files(
 				"Curve-X",
-				"Curve-X Files(.cvx)",
-				std::vector<std::string> { FORMAT_EXTENSION }
+				"Curve-X Files(.cvx, .cvxbin, .cvxpack)",
+				std::vector<std::string> { 
+					FORMAT_EXTENSION, 
+					CurveFile::BINARY_EXTENSION, 
+					CurvePack::EXTENSION 
+				}
+			);
+
+			import_from_files( paths );
+		}
+		//  Ctrl+P: Pack all curves into a file
+		else if ( IsKeyPressed( KEY_P ) )
+		{
+			std::string path = Utils::get_user_save_file(
+				"Curve-X",
+				"Curve-X Pack Files(.cvxpack)",
+				std::vector<std::string> { CurvePack::EXTENSION }
 			);
 
-			for ( const auto& path : paths )
+			if ( path.length() > 0 )
+			{
+				path = Utils::replace_extension( path, CurvePack::EXTENSION );
+				export_to_pack( path );
+			}
+		}
+		//  Ctrl+B: Bake to a file next to the current file
+		else if ( is_valid_selected_curve() && IsKeyPressed( KEY_B ) )
+		{
+			const ref<CurveLayer>& layer = get_selected_curve_layer();
+			std::string path = layer->path;
+
+			if ( !layer->is_file_exists )
+			{
+				path = Utils::get_user_save_file(
+					"Curve-X",
+					"Curve-X Baked Files(.cvxb)",
+					std::vector<std::string> { BakedCurve::EXTENSION }
+				);
+			}
+
+			if ( path.length() > 0 )
+			{
+				path = Utils::replace_extension( path, BakedCurve::EXTENSION );
+
+				CurveBakeOptions options {};
+				options.samples_count = settings::BAKE_RESOLUTION;
+				options.max_error = settings::BAKE_MAX_ERROR;
+				//  Alt-down: Bake with adaptive knots
+				options.layout = IsKeyDown( KEY_LEFT_ALT )
+					? BakedCurveLayout::Adaptive
+					: BakedCurveLayout::Uniform;
+				//  Shift-down: Bake with half precision
+				options.precision = is_shift_down
+					? BakedCurvePrecision::Half
+					: BakedCurvePrecision::Float;
+				bake_to_file( layer, path, options );
+			}
+		}
+		//  Ctrl+H: Generate a C++ header next to the current file
+		else if ( is_valid_selected_curve() && IsKeyPressed( KEY_H ) )
+		{
+			const ref<CurveLayer>& layer = get_selected_curve_layer();
+			std::string path = layer->path;
+
+			if ( !layer->is_file_exists )
+			{
+				path = Utils::get_user_save_file(
+					"Curve-X",
+					"C++ Header Files(.h)",
+					std::vector<std::string> { CurveHeaderExporter::EXTENSION }
+				);
+			}
+
+			if ( path.length() > 0 )
+			{
+				path = Utils::replace_extension( 
+					path, CurveHeaderExporter::EXTENSION );
+				export_to_header( layer, path );
+			}
+		}
+		//  Ctrl+T: Dump traced scopes
+		else if ( IsKeyPressed( KEY_T ) )
+		{
+#ifdef CURVE_EDITOR_X_ENABLE_TRACING
+			if ( Tracer::write_to_file( settings::TRACE_FILE_PATH ) )
+			{
+				printf( "Dumped traced scopes to file '%s'\n", 
+					settings::TRACE_FILE_PATH );
+			}
+			else
 			{
-				import_from_file( path );
+				printf( "File '%s' isn't writtable, aborting trace dump!\n", 
+					settings::TRACE_FILE_PATH );
 			}
+#else
+			printf( "Tracing is disabled, build with "
+				"CURVE_EDITOR_X_ENABLE_TRACING to dump traced scopes!\n" );
+#endif
 		}
 		//  Ctrl+;: Toggle debug mode
 		else if ( IsKeyPressed( KEY_COMMA ) )
 		{
 			_is_debug_enabled = !_is_debug_enabled;
+			Profiler::set_enabled( _is_debug_enabled );
+			mark_dirty();
 		}
 	}
 
+	//  Redraw when the window's content may have been lost
+	const bool is_window_focused = IsWindowFocused();
+	if ( IsWindowResized() || is_window_focused != _is_window_focused )
+	{
+		_is_window_focused = is_window_focused;
+		mark_dirty();
+	}
+
 	//  Reset inputs
 	_key_inputs.clear();
 	_has_new_mouse_clicks = false;
@@ -127,7 +257,10 @@ void Application::update( float dt )
 				//  Pass any mouse inputs to that widget
 				for ( const auto& input : _key_inputs )
 				{
-					new_focus->consume_input( input );
+					if ( new_focus->consume_input( input ) )
+					{
+						new_focus->mark_dirty();
+					}
 				}
 				_key_inputs.clear();
 
@@ -150,25 +283,30 @@ void Application::update( float dt )
 	lock_widgets_vector( true );
 
 	//  Propagate inputs to widgets
-	for ( const auto& input : _key_inputs )
 	{
-		//  Prioritizing sending inputs to the focused widget
-		if ( _focused_widget != nullptr 
-		  && _focused_widget->consume_input( input ) )
-		{
-			printf( "Focused widget consumed the input!\n" );
-			continue;
-		}
-		/*else if ( _focused_widget != nullptr )
+		TRACE_SCOPE( "Application::dispatch_inputs" );
+		for ( const auto& input : _key_inputs )
 		{
-			printf( "Focused widget didn't consumed the input!" );
-		}*/
+			//  Prioritizing sending inputs to the focused widget
+			if ( _focused_widget != nullptr 
+			  && _focused_widget->consume_input( input ) )
+			{
+				printf( "Focused widget consumed the input!\n" );
+				_focused_widget->mark_dirty();
+				continue;
+			}
+			/*else if ( _focused_widget != nullptr )
+			{
+				printf( "Focused widget didn't consumed the input!" );
+			}*/
 
-		for ( auto& widget : _widgets )
-		{
-			if ( widget->consume_input( input ) )
+			for ( auto& widget : _widgets )
 			{
-				break;
+				if ( widget->consume_input( input ) )
+				{
+					widget->mark_dirty();
+					break;
+				}
 			}
 		}
 	}
@@ -176,6 +314,7 @@ void Application::update( float dt )
 	//  Update widgets
 	for ( auto& widget : _widgets )
 	{
+		ProfilerScope scope( widget->get_name(), "update" );
 		widget->update( dt );
 	}
 
@@ -186,15 +325,22 @@ void Application::update( float dt )
 
 void Application::render()
 {
+	TRACE_SCOPE( "Application::render" );
+
 	ClearBackground( settings::BACKGROUND_COLOR );
 
 	//  Render widgets
 	lock_widgets_vector( true );
 	for ( auto& widget : _widgets )
 	{
+		ProfilerScope scope( widget->get_name(), "render" );
 		widget->render();
+		widget->clear_dirty();
 	}
 	lock_widgets_vector( false );
+	_is_dirty = false;
+
+	_render_imports_progress();
 
 	//  Debug render
 	if ( _is_debug_enabled )
@@ -207,6 +353,12 @@ void Application::render()
 		{
 			DrawRectangleLinesEx( _focused_widget->frame, 2.0f, RED );
 		}
+
+		//  Draw profiler overlay
+		Profiler::render( Vector2 { 
+			_frame.x + settings::FRAME_PADDING, 
+			_frame.y + settings::FRAME_PADDING * 2.0f,
+		} );
 	}
 }
 
@@ -229,12 +381,40 @@ void Application::invalidate_layout()
 	_invalidate_widgets();
 }
 
+void Application::mark_dirty()
+{
+	_is_dirty = true;
+}
+
+bool Application::is_dirty() const
+{
+	if ( _is_dirty ) return true;
+
+	for ( const auto& widget : _widgets )
+	{
+		if ( widget->is_dirty() ) return true;
+	}
+
+	return false;
+}
+
+bool Application::is_saving_pack( const ref<CurvePack>& pack ) const
+{
+	return _saver.is_saving_pack( pack );
+}
+
+bool Application::is_busy() const
+{
+	return _importer.is_busy() || _saver.is_busy();
+}
+
 void Application::focus_widget( ref<Widget> widget )
 {
 	//  Prevent focusing once again the same widget
 	if ( widget == _focused_widget ) return;
 
 	unfocus_widget();
+	mark_dirty();
 
 	if ( widget == nullptr ) return;
 
@@ -257,83 +437,259 @@ void Application::set_title( const std::string& title )
 	_title = title;
 }
 
-bool Application::export_to_file( 
+void Application::export_to_file( 
 	ref<CurveLayer> layer, 
 	const std::string& path 
 )
 {
+	TRACE_SCOPE( "Application::export_to_file" );
+
+	//  Saving a packed curve elsewhere moves it out of its pack once
+	//  saved, see _update_saves
+	_load_curve_layer( layer );
+
+	//  Serialize a snapshot of the curve into the file
+	_saver.save( layer, path );
+	mark_dirty();
+}
+
+bool Application::import_from_file( const std::string& path )
+{
+	TRACE_SCOPE( "Application::import_from_file" );
+
+	//  Unserialize the mapped file into curve
+	CurveImportResult result {};
+	result.path = path;
+	result.is_success = CurveFile::load_from_file(
+		path, &result.curve, &result.format, &result.error );
+	if ( !_add_imported_curve_layer( result ) ) return false;
+
+	_curve_editor->fit_viewport();
+	return true;
+}
+
+void Application::import_from_files( const std::vector<std::string>& paths )
+{
+	//  Packs only read their table of contents, opened right away
+	std::vector<std::string> file_paths;
+	for ( const std::string& path : paths )
+	{
+		if ( IsFileExtension( path.c_str(), 
+			TextFormat( ".%s", CurvePack::EXTENSION ) ) )
+		{
+			import_from_pack( path );
+		}
+		else
+		{
+			file_paths.push_back( path );
+		}
+	}
+	if ( file_paths.empty() ) return;
+
+	_importer.import_files( file_paths );
+	mark_dirty();
+}
+
+bool Application::import_from_pack( const std::string& path )
+{
+	TRACE_SCOPE( "Application::import_from_pack" );
+
 	const char* c_path = path.c_str();
-	std::ofstream file;
-	file.open( c_path );
 
-	//  Check file exists
-	if ( !file.is_open() )
+	auto pack = std::make_shared<CurvePack>();
+	if ( !pack->open( path ) )
 	{
 		printf( 
-			"File '%s' isn't writtable, aborting export from file!\n", 
+			"Pack '%s' is invalid, aborting import from pack!\n", 
 			c_path
 		);
 		return false;
 	}
 
-	//  Serialize curve
-	CurveSerializer serializer;
-	std::string data = serializer.serialize( layer->curve );
+	//  List the curves from the table of contents, decoding them 
+	//  once selected or visible
+	const int entries_count = pack->get_entries_count();
+	for ( int i = 0; i < entries_count; i++ )
+	{
+		auto layer = std::make_shared<CurveLayer>();
+		layer->set_pack_entry( pack, i );
+		layer->path = path;
+		layer->name = pack->get_entry_name( i );
+		layer->color = _get_curve_color_at( (int)_curve_layers.size() );
+		layer->is_selected = i == entries_count - 1;
+		layer->is_file_exists = true;
+		layer->has_unsaved_changes = false;
+		add_curve_layer( layer );
+	}
 
-	//  Write data to file
-	file << data;
-	file.close();
+	_curve_editor->fit_viewport();
 
-	//  Apply file
-	layer->has_unsaved_changes = false;
-	layer->is_file_exists = true;
-	layer->path = path;
-	layer->name = GetFileNameWithoutExt( c_path );
+	printf( "Imported %d curves from pack '%s'\n", entries_count, c_path );
+	return true;
+}
 
-	printf( "Exported curve '%s' to file '%s'\n", 
-		layer->name.c_str(), c_path );
+bool Application::save_pack( ref<CurvePack> pack )
+{
+	TRACE_SCOPE( "Application::save_pack" );
+
+	//  Entries are re-ordered by the previous save
+	if ( _saver.is_saving_pack( pack ) )
+	{
+		printf( 
+			"Pack '%s' is still being saved, aborting save of pack!\n", 
+			pack->get_path().c_str()
+		);
+		return false;
+	}
+
+	//  Layers of the pack, only re-writting the changed ones
+	std::vector<ref<CurveLayer>> layers;
+	for ( const ref<CurveLayer>& layer : _curve_layers )
+	{
+		if ( layer->pack != pack ) continue;
+
+		layers.push_back( layer );
+	}
+
+	//  Write a snapshot of the changed curves into the pack
+	_saver.save_pack( pack, layers );
+	mark_dirty();
 	return true;
 }
 
-bool Application::import_from_file( const std::string& path )
+bool Application::export_to_pack( const std::string& path )
+{
+	TRACE_SCOPE( "Application::export_to_pack" );
+
+	const char* c_path = path.c_str();
+
+	std::vector<CurvePackItem> items;
+	for ( const ref<CurveLayer>& layer : _curve_layers )
+	{
+		_load_curve_layer( layer );
+
+		CurvePackItem item {};
+		item.name = layer->name;
+		item.curve = &layer->curve;
+		items.push_back( item );
+	}
+
+	if ( !CurvePack::create( path, items ) )
+	{
+		printf( 
+			"File '%s' isn't writtable, aborting export to pack!\n", 
+			c_path
+		);
+		return false;
+	}
+
+	printf( "Packed %d curves into file '%s'\n", (int)items.size(), c_path );
+	return true;
+}
+
+bool Application::export_to_header(
+	ref<CurveLayer> layer,
+	const std::string& path
+)
 {
+	TRACE_SCOPE( "Application::export_to_header" );
+
 	const char* c_path = path.c_str();
-	std::ifstream file;
+
+	//  Check curve is evaluable
+	if ( layer->curve.get_keys_count() < 2 )
+	{
+		printf( 
+			"Curve '%s' doesn't have enough keys, aborting header export!\n", 
+			layer->name.c_str()
+		);
+		return false;
+	}
+
+	std::ofstream file;
 	file.open( c_path );
 
 	//  Check file exists
 	if ( !file.is_open() )
 	{
 		printf( 
-			"File '%s' doesn't exists, aborting import from file!\n", 
+			"File '%s' isn't writtable, aborting header export!\n", 
 			c_path
 		);
 		return false;
 	}
 
-	//  Read file's content
-	std::string data;
-	for ( std::string line; std::getline( file, line ); )
+	//  Generate header
+	file << CurveHeaderExporter::generate( 
+		layer->name, layer->get_time_evaluator() );
+	file.close();
+
+	printf( "Exported curve '%s' to header '%s'\n", 
+		layer->name.c_str(), c_path );
+	return true;
+}
+
+bool Application::bake_to_file(
+	ref<CurveLayer> layer,
+	const std::string& path,
+	const CurveBakeOptions& options
+)
+{
+	TRACE_SCOPE( "Application::bake_to_file" );
+
+	const char* c_path = path.c_str();
+
+	//  Check curve is evaluable
+	if ( layer->curve.get_keys_count() < 2 )
+	{
+		printf( 
+			"Curve '%s' doesn't have enough keys, aborting bake!\n", 
+			layer->name.c_str()
+		);
+		return false;
+	}
+
+	//  Half floats can't reach any error
+	if ( options.layout == BakedCurveLayout::Adaptive
+	  && options.precision == BakedCurvePrecision::Half )
 	{
-		data += line + '\n';
+		const float half_precision = CurveBaker::get_half_precision( layer->curve );
+		if ( options.max_error < half_precision )
+		{
+			printf(
+				"Curve '%s' is too large for a %g error in half precision, "
+				"using %g instead\n",
+				layer->name.c_str(), options.max_error, half_precision
+			);
+		}
 	}
-	file.close();
 
-	//  Unserialize data into curve
-	CurveSerializer serializer;
-	auto layer = std::make_shared<CurveLayer>();
-	layer->curve = serializer.unserialize( data );
-	layer->path = path;
-	layer->name = GetFileNameWithoutExt( path.c_str() );
-	layer->color = _get_curve_color_at( (int)_curve_layers.size() );
-	layer->is_selected = true;
-	layer->is_file_exists = true;
-	layer->has_unsaved_changes = false;
-	add_curve_layer( layer );
+	//  Bake curve
+	const BakedCurve baked_curve = CurveBaker::bake( layer->curve, options );
 
-	_curve_editor->fit_viewport();
+	//  Write to file
+	if ( !CurveBaker::write_to_file( baked_curve, options.precision, path ) )
+	{
+		printf( 
+			"File '%s' isn't writtable, aborting bake to file!\n", 
+			c_path
+		);
+		return false;
+	}
 
-	printf( "Imported curve from file '%s'\n", c_path );
+	//  Report error to pick the resolution
+	CurveBakeReport report = CurveBaker::measure( baked_curve, layer->curve );
+	report.file_size = CurveBaker::get_file_size( baked_curve, options.precision );
+	printf( 
+		"Baked curve '%s' to file '%s' (%s, %d samples, %s precision, "
+		"%zu bytes), max error: %g at time %g\n",
+		layer->name.c_str(), c_path,
+		options.layout == BakedCurveLayout::Adaptive ? "adaptive" : "uniform",
+		report.samples_count,
+		options.precision == BakedCurvePrecision::Half ? "half" : "float",
+		report.file_size,
+		report.max_error, report.max_error_time
+	);
 	return true;
 }
 
@@ -351,6 +707,7 @@ void Application::add_curve_layer( ref<CurveLayer> layer )
 	//  Create a layer row widget
 	auto widget = _curve_layers_tab->create_layer_row( layer );
 	add_widget( widget );
+	mark_dirty();
 }
 
 void Application::remove_curve_layer( ref<CurveLayer> layer )
@@ -369,6 +726,7 @@ void Application::remove_curve_layer( ref<CurveLayer> layer )
 
 	//  Remove the layer row widget
 	_curve_layers_tab->remove_layer_row( layer );
+	mark_dirty();
 }
 
 void Application::unselect_curve_layer()
@@ -389,11 +747,13 @@ void Application::select_curve_layer( int layer_id )
 
 	//  Select specified layer
 	auto& layer = _curve_layers.at( layer_id );
+	_load_curve_layer( layer );
 	layer->is_selected = true;
 	_selected_curve_id = layer_id;
 
 	//  Set title to layer's filename
 	set_title( Utils::get_filename_from_path( layer->path ) );
+	mark_dirty();
 }
 
 int Application::get_selected_curve_id() const
@@ -435,6 +795,7 @@ void Application::_invalidate_widgets()
 	for ( auto& widget : _widgets )
 	{
 		widget->invalidate_layout();
+		widget->mark_dirty();
 	}
 	lock_widgets_vector( false );
 }
@@ -491,6 +852,169 @@ void Application::_detect_key_input(
 	}
 }
 
+void Application::_update_imports()
+{
+	if ( !_importer.is_busy() ) return;
+
+	TRACE_SCOPE( "Application::_update_imports" );
+
+	//  Keep rendering frames for the progress
+	mark_dirty();
+
+	std::vector<CurveImportResult> results = 
+		_importer.pop_results( settings::IMPORT_BATCH_SIZE );
+	for ( CurveImportResult& result : results )
+	{
+		_add_imported_curve_layer( result );
+	}
+
+	//  Fit the viewport once for the whole batch
+	if ( !results.empty() && !_importer.is_busy() )
+	{
+		_curve_editor->fit_viewport();
+	}
+}
+
+void Application::_render_imports_progress()
+{
+	if ( !_importer.is_busy() ) return;
+
+	const int requested_count = _importer.get_requested_count();
+	const int loaded_count = _importer.get_loaded_count();
+	const float ratio = (float)loaded_count / (float)requested_count;
+
+	//  Bar along the bottom of the frame
+	Rectangle bar {
+		_frame.x,
+		_frame.y + _frame.height - settings::IMPORT_PROGRESS_HEIGHT,
+		_frame.width,
+		settings::IMPORT_PROGRESS_HEIGHT,
+	};
+	DrawRectangleRec( bar, settings::ROW_BACKGROUND_COLOR );
+	bar.width *= ratio;
+	DrawRectangleRec( bar, settings::IMPORT_PROGRESS_COLOR );
+
+	//  Count text above it
+	DrawText(
+		TextFormat( "Importing %d/%d curves", loaded_count, requested_count ),
+		(int)_frame.x,
+		(int)( bar.y - settings::IMPORT_PROGRESS_FONT_SIZE 
+			- settings::IMPORT_PROGRESS_HEIGHT ),
+		settings::IMPORT_PROGRESS_FONT_SIZE,
+		settings::TEXT_COLOR
+	);
+}
+
+void Application::_load_curve_layer( const ref<CurveLayer>& layer )
+{
+	if ( layer->is_loaded() ) return;
+
+	//  The pack belongs to the saving thread until its save is applied
+	if ( _saver.is_saving_pack( layer->pack ) )
+	{
+		_saver.wait();
+		_update_saves();
+	}
+
+	layer->load();
+}
+
+void Application::_update_saves()
+{
+	if ( !_saver.is_busy() ) return;
+
+	for ( const CurveSaveResult& result : _saver.pop_results() )
+	{
+		const char* c_path = result.path.c_str();
+
+		if ( !result.is_success )
+		{
+			printf( 
+				"File '%s' isn't writtable, aborting export from file!\n", 
+				c_path
+			);
+			continue;
+		}
+
+		//  Layer removed during the save
+		ref<CurveLayer> layer = result.layer.lock();
+		if ( layer == nullptr ) continue;
+
+		//  Apply file, changes made during the save are still unsaved
+		if ( layer->revision == result.revision )
+		{
+			layer->has_unsaved_changes = false;
+		}
+		layer->is_file_exists = true;
+		layer->path = result.path;
+		layer->pack = nullptr;
+		layer->pack_entry_id = -1;
+		layer->name = GetFileNameWithoutExt( c_path );
+		mark_dirty();
+
+		printf( "Exported curve '%s' to file '%s'\n", 
+			layer->name.c_str(), c_path );
+	}
+
+	for ( const CurvePackSaveResult& result : _saver.pop_pack_results() )
+	{
+		const char* c_path = result.pack->get_path().c_str();
+
+		if ( !result.is_success )
+		{
+			printf( 
+				"Pack '%s' isn't writtable, aborting save of pack!\n", 
+				c_path
+			);
+			continue;
+		}
+
+		//  Entries now follow the layers order
+		for ( size_t i = 0; i < result.layers.size(); i++ )
+		{
+			ref<CurveLayer> layer = result.layers[i].lock();
+			if ( layer == nullptr || layer->pack != result.pack ) continue;
+
+			layer->pack_entry_id = (int)i;
+			if ( layer->revision == result.revisions[i] )
+			{
+				layer->has_unsaved_changes = false;
+			}
+		}
+		mark_dirty();
+
+		printf( "Saved %d curves into pack '%s'\n", 
+			(int)result.layers.size(), c_path );
+	}
+}
+
+bool Application::_add_imported_curve_layer( CurveImportResult& result )
+{
+	const char* c_path = result.path.c_str();
+
+	if ( !result.is_success )
+	{
+		printf( 
+			"File '%s' is invalid (%s), aborting import from file!\n", 
+			c_path, result.error.c_str()
+		);
+		return false;
+	}
+
+	auto layer = std::make_shared<CurveLayer>( result.curve );
+	layer->file_format = result.format;
+	layer->path = result.path;
+	layer->name = GetFileNameWithoutExt( c_path );
+	layer->color = _get_curve_color_at( (int)_curve_layers.size() );
+	layer->is_selected = true;
+	layer->is_file_exists = true;
+	layer->has_unsaved_changes = false;
+	add_curve_layer( layer );
+
+	printf( "Imported curve from file '%s'\n", c_path );
+	return true;
+}
+
 Color Application::_get_curve_color_at( int index )
 {
 	switch ( index )
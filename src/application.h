@@ -5,7 +5,10 @@
 
 #include <string>
 
+#include <src/curve-baker.h>
+#include <src/curve-importer.h>
 #include <src/curve-layer.h>
+#include <src/curve-saver.h>
 #include <src/user-input.h>
 
 #include <src/widgets/widget-manager.h>
@@ -29,15 +32,78 @@ namespace curve_editor_x
 
 		void invalidate_layout();
 
+		/*
+		 * Requests the whole application to be rendered on the next
+		 * frame, for changes outside of widgets.
+		 */
+		void mark_dirty();
+		/*
+		 * Returns whether any widget changed since the last render.
+		 */
+		bool is_dirty() const;
+		/*
+		 * Returns whether work is running in the background, e.g.
+		 * importing or saving files, requiring frames to collect it.
+		 */
+		bool is_busy() const;
+		/*
+		 * Returns whether the pack is being saved in the background,
+		 * during which its curves can't be decoded.
+		 */
+		bool is_saving_pack( const ref<CurvePack>& pack ) const;
+
 		void focus_widget( ref<Widget> widget );
 		void unfocus_widget();
 
 		void set_title( const std::string& title );
-		bool export_to_file( 
+		/*
+		 * Saves a snapshot of the curve in the background, the layer
+		 * being marked as saved once written, unless it changed
+		 * in the meantime. A packed layer only leaves its pack once
+		 * written.
+		 */
+		void export_to_file( 
 			ref<CurveLayer> layer, 
 			const std::string& path 
 		);
 		bool import_from_file( const std::string& path );
+		/*
+		 * Loads the files in parallel without blocking, adding their
+		 * layers in batches over the next frames.
+		 */
+		void import_from_files( const std::vector<std::string>& paths );
+		/*
+		 * Lists the curves of a pack as layers from its table of
+		 * contents, their keys being decoded on demand.
+		 */
+		bool import_from_pack( const std::string& path );
+		/*
+		 * Writes the changed curves of the pack's layers and its new
+		 * table of contents in the background, dropping the removed 
+		 * layers.
+		 */
+		bool save_pack( ref<CurvePack> pack );
+		/*
+		 * Writes all curve layers into a new pack.
+		 */
+		bool export_to_pack( const std::string& path );
+		/*
+		 * Generates a C++ header embedding the curve's time-evaluation
+		 * as 'constexpr' data & function.
+		 */
+		bool export_to_header(
+			ref<CurveLayer> layer,
+			const std::string& path
+		);
+		/*
+		 * Bakes the curve into a sampled table for runtime 
+		 * time-evaluation, printing its maximum error.
+		 */
+		bool bake_to_file(
+			ref<CurveLayer> layer,
+			const std::string& path,
+			const CurveBakeOptions& options
+		);
 
 		void add_curve_layer( ref<CurveLayer> layer );
 		void remove_curve_layer( ref<CurveLayer> layer );
@@ -67,6 +133,23 @@ namespace curve_editor_x
 			const InputKey input_type
 		);
 
+		/*
+		 * Adds the loaded layers of the importer and fits the 
+		 * viewport once all files are imported.
+		 */
+		void _update_imports();
+		void _render_imports_progress();
+		/*
+		 * Applies the finished saves to their layers.
+		 */
+		void _update_saves();
+		/*
+		 * Decodes a packed layer, waiting for its pack to be saved
+		 * first if needed.
+		 */
+		void _load_curve_layer( const ref<CurveLayer>& layer );
+		bool _add_imported_curve_layer( CurveImportResult& result );
+
 		Color _get_curve_color_at( int index );
 
 	private:
@@ -84,8 +167,15 @@ namespace curve_editor_x
 		std::vector<ref<CurveLayer>> _curve_layers {};
 		int _selected_curve_id = 0;
 
+		CurveImporter _importer;
+		CurveSaver _saver {};
+
 		//  Has mouse clicks been received this frame?
 		bool _has_new_mouse_clicks = false;
 		bool _is_debug_enabled = false;
+
+		//  Has anything changed outside of widgets since last render?
+		bool _is_dirty = true;
+		bool _is_window_focused = true;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "atomic-file.h"
+
+#include <cstdio>
+
+//  Kept apart from raylib, whose names collide with Windows' ones
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace curve_editor_x;
+
+#ifndef _WIN32
+static bool write_all( int file, const char* data, size_t size )
+{
+	while ( size > 0 )
+	{
+		const ssize_t written = ::write( file, data, size );
+		if ( written < 0 )
+		{
+			if ( errno == EINTR ) continue;
+			return false;
+		}
+
+		data += written;
+		size -= (size_t)written;
+	}
+
+	return true;
+}
+
+static void sync_parent_directory( const std::string& path )
+{
+	const size_t separator = path.find_last_of( '/' );
+	const std::string directory = separator == std::string::npos
+		? "."
+		: path.substr( 0, separator + 1 );
+
+	const int file = ::open( directory.c_str(), O_RDONLY );
+	if ( file < 0 ) return;
+
+	fsync( file );
+	::close( file );
+}
+#endif
+
+bool AtomicFile::write(
+	const std::string& path,
+	const void* data,
+	size_t size
+)
+{
+	const std::string temp_path = get_temp_path( path );
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(
+		temp_path.c_str(),
+		GENERIC_WRITE,
+		0,
+		NULL,
+		CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL,
+		NULL
+	);
+	if ( file == INVALID_HANDLE_VALUE ) return false;
+
+	const char* bytes = (const char*)data;
+	bool is_success = true;
+	while ( is_success && size > 0 )
+	{
+		const DWORD chunk_size = size > MAXDWORD ? MAXDWORD : (DWORD)size;
+
+		DWORD written = 0;
+		is_success = WriteFile( 
+			file, bytes, chunk_size, &written, NULL ) != FALSE;
+		bytes += written;
+		size -= written;
+	}
+	is_success = is_success && FlushFileBuffers( file ) != FALSE;
+	CloseHandle( file );
+
+	if ( !is_success
+	  || !MoveFileExA( temp_path.c_str(), path.c_str(),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) )
+	{
+		DeleteFileA( temp_path.c_str() );
+		return false;
+	}
+#else
+	const int file = ::open(
+		temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+	if ( file < 0 ) return false;
+
+	//  Flush the content before the rename, which could otherwise
+	//  reach the disk first
+	bool is_success = write_all( file, (const char*)data, size )
+		&& fsync( file ) == 0;
+	is_success = ::close( file ) == 0 && is_success;
+
+	if ( !is_success || rename( temp_path.c_str(), path.c_str() ) != 0 )
+	{
+		remove( temp_path.c_str() );
+		return false;
+	}
+
+	//  Persist the rename itself
+	sync_parent_directory( path );
+#endif
+
+	return true;
+}
+
+std::string AtomicFile::get_temp_path( const std::string& path )
+{
+	return path + TEMP_EXTENSION;
+}
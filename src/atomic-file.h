@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace curve_editor_x
+{
+	/*
+	 * Replaces files without ever leaving them half-written: data is
+	 * written to a temporary file next to the target, flushed to the
+	 * disk, then renamed over the target.
+	 *
+	 * A crash leaves either the previous or the new content, and at
+	 * worst a stale temporary file.
+	 *
+	 * Supported OS: Windows & POSIX
+	 */
+	class AtomicFile
+	{
+	public:
+		static constexpr const char* TEMP_EXTENSION = ".tmp";
+
+	public:
+		/*
+		 * Returns false if any step fails, the target being then
+		 * left untouched.
+		 */
+		static bool write(
+			const std::string& path,
+			const void* data,
+			size_t size
+		);
+
+		static std::string get_temp_path( const std::string& path );
+	};
+}
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Standalone loader & sampler of baked curves, it doesn't depend on
+ * the editor nor on the curve-x library so it can be copied as-is
+ * inside a runtime.
+ *
+ * A baked curve replaces time-evaluation by a table of values sampled
+ * between the first and last key's times, either:
+ * - uniformly: sampling is an index computation and a linear 
+ *   interpolation
+ * - at adaptive knots: sampling looks up a uniform index table over 
+ *   the knots, then scans the few knots of the bucket before the 
+ *   linear interpolation
+ *
+ * File layout (little-endian):
+ * - BakedCurveHeader
+ * - Adaptive only: 'samples_count' knots times, as 32-bits floats
+ * - 'samples_count' values, either as 32-bits or 16-bits floats
+ */
+
+namespace curve_editor_x
+{
+	enum class BakedCurvePrecision : uint8_t
+	{
+		Float,
+		Half,
+	};
+
+	enum class BakedCurveLayout : uint8_t
+	{
+		Uniform,
+		Adaptive,
+	};
+
+	struct BakedCurveHeader
+	{
+		char magic[4] { 'C', 'X', 'B', 'K' };
+		uint16_t version = 1;
+		BakedCurvePrecision precision = BakedCurvePrecision::Float;
+		BakedCurveLayout layout = BakedCurveLayout::Uniform;
+		uint32_t samples_count = 0;
+		float min_time = 0.0f;
+		float max_time = 0.0f;
+	};
+
+	class BakedCurve
+	{
+	public:
+		static constexpr const char* EXTENSION = "cvxb";
+
+	public:
+		BakedCurve() {}
+		BakedCurve(
+			float min_time,
+			float max_time,
+			const std::vector<float>& values
+		)
+			: _min_time( min_time ), _max_time( max_time ),
+			  _values( values )
+		{
+			_compute_time_scale();
+		}
+		BakedCurve(
+			const std::vector<float>& times,
+			const std::vector<float>& values
+		)
+			: _min_time( times.front() ), _max_time( times.back() ),
+			  _times( times ), _values( values )
+		{
+			_compute_time_scale();
+			_compute_knots_index();
+		}
+
+		/*
+		 * Samples the curve at the given time, clamped to the baked
+		 * time range.
+		 */
+		float sample( float time ) const
+		{
+			if ( !_times.empty() ) return _sample_adaptive( time );
+
+			const float position = ( time - _min_time ) * _time_scale;
+			if ( !( position > 0.0f ) ) return _values.front();
+
+			const int last_id = (int)_values.size() - 1;
+			const int id = (int)position;
+			if ( id >= last_id ) return _values.back();
+
+			const float ratio = position - (float)id;
+			return _values[id] + ( _values[id + 1] - _values[id] ) * ratio;
+		}
+
+		bool load_from_file( const std::string& path )
+		{
+			std::ifstream file( path, std::ios::binary | std::ios::ate );
+			if ( !file.is_open() ) return false;
+
+			const std::streamoff size = file.tellg();
+			if ( size < 0 ) return false;
+
+			std::vector<char> data( (size_t)size );
+			file.seekg( 0 );
+			if ( !file.read( data.data(), data.size() ) ) return false;
+
+			return load_from_memory( data.data(), data.size() );
+		}
+
+		bool load_from_memory( const void* data, size_t size )
+		{
+			//  Check header
+			BakedCurveHeader header;
+			if ( size < sizeof( header ) ) return false;
+			memcpy( &header, data, sizeof( header ) );
+			if ( memcmp( header.magic, BakedCurveHeader().magic, 4 ) != 0
+			  || header.version != BakedCurveHeader().version
+			  || header.samples_count == 0 ) return false;
+
+			//  Check size
+			const bool is_adaptive = 
+				header.layout == BakedCurveLayout::Adaptive;
+			const size_t value_size =
+				header.precision == BakedCurvePrecision::Half ? 2 : 4;
+			const size_t times_size = 
+				is_adaptive ? header.samples_count * sizeof( float ) : 0;
+			if ( size < sizeof( header ) + times_size 
+					  + header.samples_count * value_size )
+				return false;
+
+			//  Read knots
+			const char* ptr = (const char*)data + sizeof( header );
+			std::vector<float> times( is_adaptive ? header.samples_count : 0 );
+			memcpy( times.data(), ptr, times_size );
+			ptr += times_size;
+
+			//  Check knots before keeping them, they bound the samples'
+			//  lookup
+			if ( is_adaptive )
+			{
+				if ( header.samples_count < 2
+				  || times.front() != header.min_time
+				  || times.back() != header.max_time ) return false;
+
+				for ( uint32_t i = 1; i < header.samples_count; i++ )
+				{
+					if ( !( times[i - 1] <= times[i] ) ) return false;
+				}
+			}
+			_times = std::move( times );
+
+			//  Read values
+			_values.resize( header.samples_count );
+			for ( uint32_t i = 0; i < header.samples_count; i++ )
+			{
+				if ( header.precision == BakedCurvePrecision::Half )
+				{
+					uint16_t half;
+					memcpy( &half, ptr + i * value_size, value_size );
+					_values[i] = half_to_float( half );
+				}
+				else
+				{
+					memcpy( &_values[i], ptr + i * value_size, value_size );
+				}
+			}
+
+			_min_time = header.min_time;
+			_max_time = header.max_time;
+			_compute_time_scale();
+			_compute_knots_index();
+			return true;
+		}
+
+		BakedCurveLayout get_layout() const
+		{
+			return _times.empty() 
+				? BakedCurveLayout::Uniform 
+				: BakedCurveLayout::Adaptive;
+		}
+		float get_min_time() const { return _min_time; }
+		float get_max_time() const { return _max_time; }
+		/*
+		 * Returns the time of a sample, for both layouts.
+		 */
+		float get_time_at( int sample_id ) const
+		{
+			if ( !_times.empty() ) return _times[sample_id];
+
+			const float ratio = (float)sample_id / (float)( _values.size() - 1 );
+			return _min_time * ( 1.0f - ratio ) + _max_time * ratio;
+		}
+		const std::vector<float>& get_times() const { return _times; }
+		const std::vector<float>& get_values() const { return _values; }
+
+		static float half_to_float( uint16_t half )
+		{
+			const uint32_t sign = ( half & 0x8000u ) << 16;
+			const uint32_t exponent = ( half >> 10 ) & 0x1Fu;
+			const uint32_t mantissa = half & 0x3FFu;
+
+			//  Zero & sub-normals
+			if ( exponent == 0 )
+			{
+				const float value = ldexpf( (float)mantissa, -24 );
+				return sign ? -value : value;
+			}
+
+			//  Infinity & NaN
+			uint32_t bits;
+			if ( exponent == 0x1Fu )
+			{
+				bits = sign | 0x7F800000u | ( mantissa << 13 );
+			}
+			else
+			{
+				bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+			}
+
+			float value;
+			memcpy( &value, &bits, sizeof( value ) );
+			return value;
+		}
+
+		static uint16_t float_to_half( float value )
+		{
+			uint32_t bits;
+			memcpy( &bits, &value, sizeof( bits ) );
+
+			const uint16_t sign = (uint16_t)( ( bits >> 16 ) & 0x8000u );
+			const int exponent = (int)( ( bits >> 23 ) & 0xFFu ) - 127 + 15;
+			uint32_t mantissa = bits & 0x7FFFFFu;
+
+			//  NaN & infinity (including overflows)
+			if ( ( ( bits >> 23 ) & 0xFFu ) == 0xFFu )
+			{
+				return sign | 0x7C00u | ( mantissa ? 0x200u : 0u );
+			}
+			if ( exponent >= 0x1F ) return sign | 0x7C00u;
+
+			//  Sub-normals & underflows
+			if ( exponent <= 0 )
+			{
+				if ( exponent < -10 ) return sign;
+
+				mantissa |= 0x800000u;
+				const int shift = 14 - exponent;
+				uint32_t half_mantissa = mantissa >> shift;
+				//  Round to nearest
+				if ( ( mantissa >> ( shift - 1 ) ) & 1u ) half_mantissa++;
+				return sign | (uint16_t)half_mantissa;
+			}
+
+			//  Round to nearest, a carry correctly bumps the exponent
+			uint32_t half = ( (uint32_t)exponent << 10 ) | ( mantissa >> 13 );
+			if ( mantissa & 0x1000u ) half++;
+			return sign | (uint16_t)half;
+		}
+
+	private:
+		float _sample_adaptive( float time ) const
+		{
+			if ( !( time > _min_time ) ) return _values.front();
+			if ( time >= _max_time ) return _values.back();
+
+			//  Start from the last knot before the bucket, then scan
+			int id = _knots_index[_get_bucket_id( time )];
+			while ( _times[id + 1] <= time ) id++;
+
+			const float duration = _times[id + 1] - _times[id];
+			const float ratio = ( time - _times[id] ) / duration;
+			return _values[id] + ( _values[id + 1] - _values[id] ) * ratio;
+		}
+
+		int _get_bucket_id( float time ) const
+		{
+			const float position = ( time - _min_time ) * _time_scale;
+			if ( !( position > 0.0f ) ) return 0;
+
+			const int last_id = (int)_knots_index.size() - 1;
+			const int id = (int)position;
+			return id < last_id ? id : last_id;
+		}
+
+		void _compute_time_scale()
+		{
+			//  Adaptive: as many buckets as intervals
+			const float duration = _max_time - _min_time;
+			_time_scale = duration > 0.0f && _values.size() > 1
+				? (float)( _values.size() - 1 ) / duration
+				: 0.0f;
+		}
+
+		void _compute_knots_index()
+		{
+			_knots_index.clear();
+			if ( _times.size() < 2 ) return;
+
+			//  Each bucket points to the last knot whose bucket precedes
+			//  it, which is thus before any time falling in this bucket
+			const int buckets_count = (int)_times.size() - 1;
+			const int last_interval_id = (int)_times.size() - 2;
+			_knots_index.resize( buckets_count );
+
+			int knot_id = 0;
+			for ( int i = 0; i < buckets_count; i++ )
+			{
+				while ( knot_id < last_interval_id
+				     && _get_bucket_id( _times[knot_id + 1] ) < i )
+				{
+					knot_id++;
+				}
+				_knots_index[i] = knot_id;
+			}
+		}
+
+	private:
+		float _min_time = 0.0f;
+		float _max_time = 0.0f;
+		//  Inverse of the time between two samples, or buckets if
+		//  adaptive
+		float _time_scale = 0.0f;
+
+		//  Adaptive only: sorted times of the knots, and the first knot
+		//  to scan from for each bucket
+		std::vector<float> _times {};
+		std::vector<int> _knots_index {};
+
+		std::vector<float> _values {};
+	};
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Standalone view of binary curves, it doesn't depend on the editor
+ * nor on the curve-x library so it can be copied as-is inside a
+ * content pipeline or a runtime.
+ *
+ * A binary curve is meant to be used in place, e.g. from a memory-
+ * mapped file: the view only validates the header and sizes, keys are
+ * then read without any parsing nor copy.
+ *
+ * File layout (little-endian, 4-bytes aligned):
+ * - BinaryCurveHeader
+ * - 'keys_count' BinaryCurveKey
+ * - 'keys_count' tangent modes, as 8-bits integers
+ */
+
+namespace curve_editor_x
+{
+	struct BinaryCurveHeader
+	{
+		char magic[4] { 'C', 'X', 'B', 'N' };
+		uint16_t version = 1;
+		uint16_t reserved = 0;
+		uint32_t keys_count = 0;
+	};
+
+	/*
+	 * Points of a key, tangents being relative to the control point.
+	 */
+	struct BinaryCurveKey
+	{
+		float control_x = 0.0f, control_y = 0.0f;
+		float left_tangent_x = 0.0f, left_tangent_y = 0.0f;
+		float right_tangent_x = 0.0f, right_tangent_y = 0.0f;
+	};
+
+	static_assert( sizeof( BinaryCurveHeader ) == 12, "Unexpected padding" );
+	static_assert( sizeof( BinaryCurveKey ) == 24, "Unexpected padding" );
+
+	class BinaryCurveView
+	{
+	public:
+		/*
+		 * Returns whether the data starts as a binary curve, to tell
+		 * it apart from other formats.
+		 */
+		static bool is_binary_curve( const void* data, size_t size )
+		{
+			return size >= sizeof( BinaryCurveHeader::magic )
+				&& memcmp( data, BinaryCurveHeader().magic,
+					sizeof( BinaryCurveHeader::magic ) ) == 0;
+		}
+
+		static size_t get_data_size( uint32_t keys_count )
+		{
+			return sizeof( BinaryCurveHeader )
+				+ keys_count * sizeof( BinaryCurveKey )
+				+ keys_count * sizeof( uint8_t );
+		}
+
+	public:
+		/*
+		 * Validates the data, which must outlive the view and be
+		 * aligned on 4 bytes.
+		 */
+		bool load_from_memory( const void* data, size_t size )
+		{
+			_header = nullptr;
+
+			if ( !is_binary_curve( data, size )
+			  || size < sizeof( BinaryCurveHeader )
+			  || ( (uintptr_t)data % alignof( BinaryCurveKey ) ) != 0 )
+				return false;
+
+			const BinaryCurveHeader* header = (const BinaryCurveHeader*)data;
+			if ( header->version != BinaryCurveHeader().version
+			  || size < get_data_size( header->keys_count ) ) return false;
+
+			_header = header;
+			return true;
+		}
+
+		bool is_valid() const
+		{
+			return _header != nullptr;
+		}
+
+		uint32_t get_keys_count() const
+		{
+			return _header->keys_count;
+		}
+		const BinaryCurveKey* get_keys() const
+		{
+			return (const BinaryCurveKey*)( _header + 1 );
+		}
+		/*
+		 * Returns the tangent mode of a key, matching the values of
+		 * curve-x's TangentMode.
+		 */
+		uint8_t get_tangent_mode( uint32_t key_id ) const
+		{
+			const uint8_t* modes = (const uint8_t*)(
+				get_keys() + _header->keys_count );
+			return modes[key_id];
+		}
+
+	private:
+		const BinaryCurveHeader* _header = nullptr;
+	};
+}
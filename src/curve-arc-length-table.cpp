@@ -0,0 +1,235 @@
+#include "curve-arc-length-table.h"
+
+#include <src/settings.h>
+#include <src/trace.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+constexpr int SAMPLES_COUNT = settings::ARC_LENGTH_SEGMENT_SAMPLES;
+constexpr int SAMPLES_STRIDE = SAMPLES_COUNT + 1;
+
+void CurveArcLengthTable::rebuild( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveArcLengthTable::rebuild" );
+
+	const int segments_count = std::max( 0, curve.get_keys_count() - 1 );
+
+	_segments.resize( segments_count );
+	_cumulative_lengths.resize( segments_count + 1 );
+	_sample_lengths.resize( segments_count * SAMPLES_STRIDE );
+
+	_cumulative_lengths[0] = 0.0f;
+	for ( int i = 0; i < segments_count; i++ )
+	{
+		_measure_segment( curve, i );
+
+		_cumulative_lengths[i + 1] = _cumulative_lengths[i]
+			+ _sample_lengths[i * SAMPLES_STRIDE + SAMPLES_COUNT];
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveArcLengthTable::update( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveArcLengthTable::update" );
+
+	const int segments_count = curve.get_keys_count() - 1;
+
+	//  Keys have been added or removed, segments are shifted
+	if ( _dirty_range.is_fully_dirty 
+	  || segments_count != (int)_segments.size() )
+	{
+		rebuild( curve );
+		return;
+	}
+	if ( !_dirty_range.is_dirty() ) return;
+
+	//  Re-measure segments on both sides of the edited keys
+	int first_segment_id, last_segment_id;
+	_dirty_range.get_segments_range( 
+		segments_count, &first_segment_id, &last_segment_id );
+	for ( int i = first_segment_id; i <= last_segment_id; i++ )
+	{
+		_measure_segment( curve, i );
+	}
+
+	//  Patch cumulative lengths of the re-measured segments
+	const float old_length = _cumulative_lengths[last_segment_id + 1];
+	for ( int i = first_segment_id; i <= last_segment_id; i++ )
+	{
+		_cumulative_lengths[i + 1] = _cumulative_lengths[i]
+			+ _sample_lengths[i * SAMPLES_STRIDE + SAMPLES_COUNT];
+	}
+
+	//  Offset the following keys by the length difference
+	const float delta = _cumulative_lengths[last_segment_id + 1] - old_length;
+	for ( int i = last_segment_id + 2; i <= segments_count; i++ )
+	{
+		_cumulative_lengths[i] += delta;
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveArcLengthTable::invalidate()
+{
+	_dirty_range.invalidate();
+}
+
+void CurveArcLengthTable::invalidate_key( int key_id )
+{
+	_dirty_range.invalidate_key( key_id );
+}
+
+bool CurveArcLengthTable::is_dirty() const
+{
+	return _dirty_range.is_dirty();
+}
+
+Point CurveArcLengthTable::evaluate_by_distance( float distance ) const
+{
+	if ( _segments.empty() ) return Point {};
+
+	int segment_id;
+	float t;
+	find_segment_by_distance( distance, &segment_id, &t );
+
+	return _segments[segment_id].evaluate( t );
+}
+
+void CurveArcLengthTable::find_evaluation_keys_id_by_distance(
+	int* first_key_id,
+	int* last_key_id,
+	float distance
+) const
+{
+	const int segment_id = _find_segment_id( distance );
+
+	*first_key_id = segment_id;
+	*last_key_id = segment_id + 1;
+}
+
+void CurveArcLengthTable::find_segment_by_distance(
+	float distance,
+	int* segment_id,
+	float* t
+) const
+{
+	*segment_id = _find_segment_id( distance );
+	*t = _find_segment_progress(
+		*segment_id,
+		distance - _cumulative_lengths[*segment_id]
+	);
+}
+
+float CurveArcLengthTable::get_distance_at( int segment_id, float t ) const
+{
+	if ( _segments.empty() ) return 0.0f;
+
+	//  Find the sample just before the progress
+	const float scaled_t = std::clamp( t, 0.0f, 1.0f ) * SAMPLES_COUNT;
+	const int sample_id = std::min( (int)scaled_t, SAMPLES_COUNT - 1 );
+	const float sample_t = (float)sample_id / (float)SAMPLES_COUNT;
+
+	//  Integrate the remaining part of the sub-interval
+	const float* samples = &_sample_lengths[segment_id * SAMPLES_STRIDE];
+	return _cumulative_lengths[segment_id] + samples[sample_id]
+		+ _segments[segment_id].get_length( sample_t, t );
+}
+
+float CurveArcLengthTable::get_length() const
+{
+	if ( _cumulative_lengths.empty() ) return 0.0f;
+	return _cumulative_lengths.back();
+}
+
+int CurveArcLengthTable::get_segments_count() const
+{
+	return (int)_segments.size();
+}
+
+void CurveArcLengthTable::_measure_segment( 
+	const Curve& curve, 
+	int segment_id 
+)
+{
+	const CurveSegment segment = CurveSegment::from_curve( curve, segment_id );
+	_segments[segment_id] = segment;
+
+	//  Measure each sub-interval of the segment
+	float* samples = &_sample_lengths[segment_id * SAMPLES_STRIDE];
+	samples[0] = 0.0f;
+	for ( int i = 1; i <= SAMPLES_COUNT; i++ )
+	{
+		const float t0 = (float)( i - 1 ) / (float)SAMPLES_COUNT;
+		const float t1 = (float)i / (float)SAMPLES_COUNT;
+		samples[i] = samples[i - 1] + segment.get_length( t0, t1 );
+	}
+}
+
+int CurveArcLengthTable::_find_segment_id( float distance ) const
+{
+	const int segments_count = (int)_segments.size();
+	if ( segments_count == 0 ) return 0;
+
+	//  Binary search the first key further than the distance
+	auto itr = std::upper_bound(
+		_cumulative_lengths.begin() + 1,
+		_cumulative_lengths.end(),
+		distance
+	);
+	const int segment_id = (int)( itr - _cumulative_lengths.begin() ) - 1;
+
+	return std::clamp( segment_id, 0, segments_count - 1 );
+}
+
+float CurveArcLengthTable::_find_segment_progress(
+	int segment_id,
+	float local_distance
+) const
+{
+	const float* samples = &_sample_lengths[segment_id * SAMPLES_STRIDE];
+	if ( local_distance <= 0.0f ) return 0.0f;
+	if ( local_distance >= samples[SAMPLES_COUNT] ) return 1.0f;
+
+	//  Binary search the sub-interval containing the distance
+	const float* itr = std::upper_bound(
+		samples + 1,
+		samples + SAMPLES_STRIDE,
+		local_distance
+	);
+	const int sample_id = std::min(
+		(int)( itr - samples ) - 1,
+		SAMPLES_COUNT - 1
+	);
+
+	//  Initial guess from linear interpolation inside the sub-interval
+	const float sample_length = samples[sample_id + 1] - samples[sample_id];
+	const float sample_t = (float)sample_id / (float)SAMPLES_COUNT;
+	const float ratio = sample_length > 0.0f
+		? ( local_distance - samples[sample_id] ) / sample_length
+		: 0.0f;
+	float t = sample_t + ratio / (float)SAMPLES_COUNT;
+
+	//  Refine with a Newton step on 'length(t) - distance'
+	const CurveSegment& segment = _segments[segment_id];
+	const Point speed = segment.derivative( t );
+	const float speed_length = sqrtf( speed.x * speed.x + speed.y * speed.y );
+	if ( speed_length > 0.0f )
+	{
+		const float error = samples[sample_id]
+			+ segment.get_length( sample_t, t ) - local_distance;
+		t -= error / speed_length;
+	}
+
+	//  Keep inside the sub-interval in case the step overshot
+	return std::clamp(
+		t,
+		sample_t,
+		(float)( sample_id + 1 ) / (float)SAMPLES_COUNT
+	);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/curve-segment.h>
+#include <src/dirty-key-range.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Cumulative arc-length table of a curve, mapping a distance along
+	 * the curve to a segment and its progress.
+	 *
+	 * Each segment is measured at a fixed number of sub-intervals so
+	 * that a query is a binary search over the segments, another one
+	 * over the segment's samples and a single Newton step.
+	 */
+	class CurveArcLengthTable
+	{
+	public:
+		/*
+		 * Re-measures all segments of the curve.
+		 */
+		void rebuild( const Curve& curve );
+		/*
+		 * Re-measures the segments invalidated since the last update
+		 * and patches the cumulative lengths, or rebuilds the whole
+		 * table if it was entirely invalidated.
+		 */
+		void update( const Curve& curve );
+
+		/*
+		 * Invalidates the whole table.
+		 */
+		void invalidate();
+		/*
+		 * Invalidates the (at most two) segments around a key.
+		 */
+		void invalidate_key( int key_id );
+		bool is_dirty() const;
+
+		Point evaluate_by_distance( float distance ) const;
+
+		/*
+		 * Finds the keys surrounding the given distance.
+		 */
+		void find_evaluation_keys_id_by_distance(
+			int* first_key_id,
+			int* last_key_id,
+			float distance
+		) const;
+
+		/*
+		 * Finds the segment and its progress at the given distance.
+		 */
+		void find_segment_by_distance(
+			float distance,
+			int* segment_id,
+			float* t
+		) const;
+
+		/*
+		 * Returns the distance from the curve's start to the given
+		 * segment progress.
+		 */
+		float get_distance_at( int segment_id, float t ) const;
+
+		float get_length() const;
+		int get_segments_count() const;
+
+	private:
+		void _measure_segment( const Curve& curve, int segment_id );
+
+		int _find_segment_id( float distance ) const;
+		float _find_segment_progress(
+			int segment_id,
+			float local_distance
+		) const;
+
+	private:
+		std::vector<CurveSegment> _segments {};
+
+		//  Distance from the curve's start to each key
+		std::vector<float> _cumulative_lengths {};
+		//  Distance from the segment's start to each of its samples,
+		//  stored contiguously for all segments
+		std::vector<float> _sample_lengths {};
+
+		DirtyKeyRange _dirty_range {};
+	};
+}
@@ -0,0 +1,297 @@
+#include "curve-baker.h"
+
+#include <src/atomic-file.h>
+#include <src/settings.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace curve_editor_x;
+
+BakedCurve CurveBaker::bake(
+	const Curve& curve,
+	const CurveBakeOptions& options
+)
+{
+	switch ( options.layout )
+	{
+		case BakedCurveLayout::Adaptive:
+			return bake_adaptive(
+				curve, options.max_error, options.precision );
+		case BakedCurveLayout::Uniform:
+		default:
+			return bake_uniform(
+				curve, options.samples_count, options.precision );
+	}
+}
+
+BakedCurve CurveBaker::bake_uniform(
+	const Curve& curve,
+	int samples_count,
+	BakedCurvePrecision precision
+)
+{
+	samples_count = std::max( 2, samples_count );
+
+	const float min_time = curve.get_key( 0 ).control.x;
+	const float max_time = curve.get_key( curve.get_keys_count() - 1 ).control.x;
+
+	std::vector<float> values( samples_count );
+	for ( int i = 0; i < samples_count; i++ )
+	{
+		//  Interpolate from both ends to land exactly on the last key
+		const float ratio = (float)i / (float)( samples_count - 1 );
+		const float time = min_time * ( 1.0f - ratio ) + max_time * ratio;
+
+		values[i] = _sample_value( curve, time, precision );
+	}
+
+	return BakedCurve( min_time, max_time, values );
+}
+
+BakedCurve CurveBaker::bake_adaptive(
+	const Curve& curve,
+	float max_error,
+	BakedCurvePrecision precision
+)
+{
+	//  Half floats can't reach a finer error, subdivisions would go
+	//  as deep as allowed without ever getting flat
+	if ( precision == BakedCurvePrecision::Half )
+	{
+		max_error = std::max( max_error, get_half_precision( curve ) );
+	}
+
+	std::vector<float> times;
+	std::vector<float> values;
+
+	//  Start with a knot on each key, where the curve may have corners
+	float time_a = curve.get_key( 0 ).control.x;
+	float value_a = curve.evaluate_by_time( time_a );
+	times.push_back( time_a );
+	values.push_back( value_a );
+
+	for ( int i = 1; i < curve.get_keys_count(); i++ )
+	{
+		const float time_b = curve.get_key( i ).control.x;
+		if ( time_b <= time_a ) continue;
+
+		const float value_b = curve.evaluate_by_time( time_b );
+		_subdivide(
+			curve, max_error,
+			time_a, value_a,
+			time_b, value_b,
+			0, &times, &values
+		);
+
+		time_a = time_b;
+		value_a = value_b;
+	}
+
+	//  Degenerated curve, keep a valid interval
+	if ( times.size() < 2 )
+	{
+		times.push_back( time_a );
+		values.push_back( value_a );
+	}
+
+	//  Round once the knots are placed, subdivision comparing the
+	//  curve to exact values
+	if ( precision == BakedCurvePrecision::Half )
+	{
+		for ( float& value : values )
+		{
+			value = BakedCurve::half_to_float( BakedCurve::float_to_half( value ) );
+		}
+	}
+
+	return BakedCurve( times, values );
+}
+
+float CurveBaker::get_half_precision( const Curve& curve )
+{
+	//  Largest magnitude the curve can reach, within its points' hull
+	float max_value = 0.0f;
+	for ( int i = 0; i < curve.get_keys_count(); i++ )
+	{
+		const CurveKey& key = curve.get_key( i );
+		max_value = std::max( { 
+			max_value,
+			fabsf( key.control.y ),
+			fabsf( key.control.y + key.left_tangent.y ),
+			fabsf( key.control.y + key.right_tangent.y ),
+		} );
+	}
+
+	//  Gap between two halfs around that magnitude, with 10 bits of
+	//  mantissa and subnormals below 2^-14
+	int exponent = 0;
+	frexpf( max_value, &exponent );
+	return ldexpf( 1.0f, std::max( exponent - 1, -14 ) - 10 );
+}
+
+CurveBakeReport CurveBaker::measure(
+	const BakedCurve& baked_curve,
+	const Curve& curve
+)
+{
+	const int samples_count = (int)baked_curve.get_values().size();
+
+	CurveBakeReport report {};
+	report.samples_count = samples_count;
+	report.max_error_time = baked_curve.get_min_time();
+
+	//  Probe inside each interval, including the samples themselves
+	for ( int i = 0; i < samples_count; i++ )
+	{
+		const float time_a = baked_curve.get_time_at( i );
+		const float time_b = i + 1 < samples_count
+			? baked_curve.get_time_at( i + 1 )
+			: time_a;
+		const int probes_count = i + 1 < samples_count
+			? settings::BAKE_ERROR_PROBES
+			: 1;
+
+		for ( int j = 0; j < probes_count; j++ )
+		{
+			const float ratio = (float)j / (float)settings::BAKE_ERROR_PROBES;
+			const float time = time_a + ( time_b - time_a ) * ratio;
+
+			const float error = fabsf(
+				baked_curve.sample( time ) - curve.evaluate_by_time( time ) );
+			if ( error > report.max_error )
+			{
+				report.max_error = error;
+				report.max_error_time = time;
+			}
+		}
+	}
+
+	return report;
+}
+
+bool CurveBaker::write_to_file(
+	const BakedCurve& baked_curve,
+	BakedCurvePrecision precision,
+	const std::string& path
+)
+{
+	const std::vector<float>& times = baked_curve.get_times();
+	const std::vector<float>& values = baked_curve.get_values();
+
+	std::vector<char> data( get_file_size( baked_curve, precision ) );
+	char* ptr = data.data();
+
+	//  Write header
+	BakedCurveHeader header {};
+	header.precision = precision;
+	header.layout = baked_curve.get_layout();
+	header.samples_count = (uint32_t)values.size();
+	header.min_time = baked_curve.get_min_time();
+	header.max_time = baked_curve.get_max_time();
+	memcpy( ptr, &header, sizeof( header ) );
+	ptr += sizeof( header );
+
+	//  Write knots
+	memcpy( ptr, times.data(), times.size() * sizeof( float ) );
+	ptr += times.size() * sizeof( float );
+
+	//  Write values
+	if ( precision == BakedCurvePrecision::Half )
+	{
+		for ( size_t i = 0; i < values.size(); i++ )
+		{
+			const uint16_t half = BakedCurve::float_to_half( values[i] );
+			memcpy( ptr, &half, sizeof( half ) );
+			ptr += sizeof( half );
+		}
+	}
+	else
+	{
+		memcpy( ptr, values.data(), values.size() * sizeof( float ) );
+	}
+
+	return AtomicFile::write( path, data.data(), data.size() );
+}
+
+size_t CurveBaker::get_file_size(
+	const BakedCurve& baked_curve,
+	BakedCurvePrecision precision
+)
+{
+	const size_t value_size =
+		precision == BakedCurvePrecision::Half ? sizeof( uint16_t ) : sizeof( float );
+	return sizeof( BakedCurveHeader )
+		 + baked_curve.get_times().size() * sizeof( float )
+		 + baked_curve.get_values().size() * value_size;
+}
+
+float CurveBaker::_sample_value(
+	const Curve& curve,
+	float time,
+	BakedCurvePrecision precision
+)
+{
+	const float value = curve.evaluate_by_time( time );
+	if ( precision == BakedCurvePrecision::Half )
+	{
+		return BakedCurve::half_to_float( BakedCurve::float_to_half( value ) );
+	}
+
+	return value;
+}
+
+void CurveBaker::_subdivide(
+	const Curve& curve,
+	float max_error,
+	float time_a, float value_a,
+	float time_b, float value_b,
+	int depth,
+	std::vector<float>* times,
+	std::vector<float>* values
+)
+{
+	const float time_middle = ( time_a + time_b ) * 0.5f;
+
+	//  Compare the line to the curve at inner probes
+	bool is_flat = true;
+	if ( depth < settings::BAKE_MAX_DEPTH
+	  && time_middle > time_a && time_middle < time_b )
+	{
+		for ( int i = 1; i < settings::BAKE_ERROR_PROBES; i++ )
+		{
+			const float ratio = (float)i / (float)settings::BAKE_ERROR_PROBES;
+			const float time = time_a + ( time_b - time_a ) * ratio;
+			const float line_value = value_a + ( value_b - value_a ) * ratio;
+
+			if ( fabsf( line_value - curve.evaluate_by_time( time ) ) > max_error )
+			{
+				is_flat = false;
+				break;
+			}
+		}
+	}
+
+	if ( is_flat )
+	{
+		times->push_back( time_b );
+		values->push_back( value_b );
+		return;
+	}
+
+	//  Split in halves, left first to keep knots sorted
+	const float value_middle = curve.evaluate_by_time( time_middle );
+	_subdivide(
+		curve, max_error,
+		time_a, value_a,
+		time_middle, value_middle,
+		depth + 1, times, values
+	);
+	_subdivide(
+		curve, max_error,
+		time_middle, value_middle,
+		time_b, value_b,
+		depth + 1, times, values
+	);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+
+#include <curve-x/curve.h>
+
+#include <src/baked-curve.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	struct CurveBakeOptions
+	{
+		BakedCurveLayout layout = BakedCurveLayout::Uniform;
+		BakedCurvePrecision precision = BakedCurvePrecision::Float;
+
+		//  Uniform: number of samples
+		int samples_count = 256;
+		//  Adaptive: maximum absolute error on the Y-axis
+		float max_error = 0.001f;
+	};
+
+	/*
+	 * Statistics of a baked curve compared to the curve's
+	 * time-evaluation.
+	 */
+	struct CurveBakeReport
+	{
+		int samples_count = 0;
+		//  Maximum absolute error on the Y-axis and its time
+		float max_error = 0.0f;
+		float max_error_time = 0.0f;
+		size_t file_size = 0;
+	};
+
+	/*
+	 * Bakes time-evaluated curves into sampled tables that can be
+	 * loaded and sampled at runtime with BakedCurve.
+	 *
+	 * Samples are taken from Curve::evaluate_by_time, so a baked
+	 * curve matches what the curve-x library evaluates.
+	 *
+	 * With half precision, values are rounded as they would be once
+	 * loaded back from a file.
+	 */
+	class CurveBaker
+	{
+	public:
+		static BakedCurve bake(
+			const Curve& curve,
+			const CurveBakeOptions& options
+		);
+		/*
+		 * Samples the curve uniformly between its first and last keys.
+		 */
+		static BakedCurve bake_uniform(
+			const Curve& curve,
+			int samples_count,
+			BakedCurvePrecision precision
+		);
+		/*
+		 * Places knots at each key, then recursively splits in halves
+		 * the intervals whose linear interpolation exceeds the maximum
+		 * error, so flat stretches only keep their ends.
+		 *
+		 * With half precision, the maximum error is raised to the
+		 * half precision at the curve's range, and knots are only
+		 * rounded once placed.
+		 */
+		static BakedCurve bake_adaptive(
+			const Curve& curve,
+			float max_error,
+			BakedCurvePrecision precision
+		);
+
+		/*
+		 * Compares the baked curve to the curve's time-evaluation at
+		 * several probes between each pair of samples.
+		 */
+		static CurveBakeReport measure(
+			const BakedCurve& baked_curve,
+			const Curve& curve
+		);
+
+		/*
+		 * Returns the gap between two half floats around the largest
+		 * value the curve can reach.
+		 */
+		static float get_half_precision( const Curve& curve );
+
+		/*
+		 * Writes the baked curve into a file, atomically replacing it.
+		 */
+		static bool write_to_file(
+			const BakedCurve& baked_curve,
+			BakedCurvePrecision precision,
+			const std::string& path
+		);
+		static size_t get_file_size(
+			const BakedCurve& baked_curve,
+			BakedCurvePrecision precision
+		);
+
+	private:
+		static float _sample_value(
+			const Curve& curve,
+			float time,
+			BakedCurvePrecision precision
+		);
+		static void _subdivide(
+			const Curve& curve,
+			float max_error,
+			float time_a, float value_a,
+			float time_b, float value_b,
+			int depth,
+			std::vector<float>* times,
+			std::vector<float>* values
+		);
+	};
+}
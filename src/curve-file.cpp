@@ -0,0 +1,177 @@
+#include "curve-file.h"
+
+#include <src/atomic-file.h>
+#include <src/binary-curve.h>
+#include <src/curve-text-parser.h>
+#include <src/mapped-file.h>
+#include <src/trace.h>
+
+#include <curve-x/curve-serializer.h>
+
+using namespace curve_editor_x;
+
+bool CurveFile::load_from_file(
+	const std::string& path,
+	Curve* curve,
+	CurveFileFormat* format,
+	std::string* error
+)
+{
+	MappedFile file;
+	if ( !file.open( path ) )
+	{
+		if ( error != nullptr ) *error = "File can't be opened";
+		return false;
+	}
+
+	return load_from_memory(
+		file.get_data(), file.get_size(), curve, format, error );
+}
+
+bool CurveFile::load_from_memory(
+	const void* data,
+	size_t size,
+	Curve* curve,
+	CurveFileFormat* format,
+	std::string* error
+)
+{
+	//  Text format, parsed in a single pass
+	if ( !BinaryCurveView::is_binary_curve( data, size ) )
+	{
+		*format = CurveFileFormat::Text;
+
+		//  Rely on the serializer if its format went out of sync
+		if ( !CurveTextParser::is_serializer_compatible() )
+		{
+			CurveSerializer serializer;
+			*curve = serializer.unserialize(
+				std::string( (const char*)data, size ) );
+			return true;
+		}
+
+		CurveTextParser parser;
+		if ( !parser.parse( std::string_view( (const char*)data, size ), curve ) )
+		{
+			if ( error != nullptr )
+			{
+				const CurveTextError& text_error = parser.get_error();
+				*error = "Line " + std::to_string( text_error.line )
+					+ ", column " + std::to_string( text_error.column )
+					+ ": " + text_error.message;
+			}
+			return false;
+		}
+		return true;
+	}
+
+	//  Binary format, read in place
+	*format = CurveFileFormat::Binary;
+
+	BinaryCurveView view;
+	if ( !view.load_from_memory( data, size ) )
+	{
+		if ( error != nullptr ) *error = "Invalid binary header or size";
+		return false;
+	}
+
+	const uint32_t keys_count = view.get_keys_count();
+	const BinaryCurveKey* keys = view.get_keys();
+
+	Curve new_curve {};
+	for ( uint32_t i = 0; i < keys_count; i++ )
+	{
+		const uint8_t tangent_mode = view.get_tangent_mode( i );
+		if ( tangent_mode >= (uint8_t)TangentMode::MAX )
+		{
+			if ( error != nullptr )
+			{
+				*error = "Invalid tangent mode of key " + std::to_string( i );
+			}
+			return false;
+		}
+
+		const BinaryCurveKey& key = keys[i];
+		new_curve.add_key( CurveKey(
+			Point { key.control_x, key.control_y },
+			Point { key.left_tangent_x, key.left_tangent_y },
+			Point { key.right_tangent_x, key.right_tangent_y },
+			(TangentMode)tangent_mode
+		) );
+	}
+
+	*curve = new_curve;
+	return true;
+}
+
+bool CurveFile::save_to_file(
+	const Curve& curve,
+	const std::string& path,
+	CurveFileFormat format
+)
+{
+	TRACE_SCOPE( "CurveFile::save_to_file" );
+
+	switch ( format )
+	{
+		case CurveFileFormat::Text:
+		{
+			CurveSerializer serializer;
+			const std::string data = serializer.serialize( curve );
+			return AtomicFile::write( path, data.data(), data.size() );
+		}
+
+		case CurveFileFormat::Binary:
+		{
+			const std::vector<char> data = serialize_binary( curve );
+			return AtomicFile::write( path, data.data(), data.size() );
+		}
+	}
+
+	return false;
+}
+
+std::vector<char> CurveFile::serialize_binary( const Curve& curve )
+{
+	const uint32_t keys_count = (uint32_t)curve.get_keys_count();
+
+	BinaryCurveHeader header {};
+	header.keys_count = keys_count;
+
+	std::vector<char> data( BinaryCurveView::get_data_size( keys_count ) );
+	char* ptr = data.data();
+	memcpy( ptr, &header, sizeof( header ) );
+	ptr += sizeof( header );
+
+	//  Keys
+	for ( uint32_t i = 0; i < keys_count; i++ )
+	{
+		const CurveKey& key = curve.get_key( (int)i );
+
+		BinaryCurveKey binary_key {};
+		binary_key.control_x = key.control.x;
+		binary_key.control_y = key.control.y;
+		binary_key.left_tangent_x = key.left_tangent.x;
+		binary_key.left_tangent_y = key.left_tangent.y;
+		binary_key.right_tangent_x = key.right_tangent.x;
+		binary_key.right_tangent_y = key.right_tangent.y;
+
+		memcpy( ptr, &binary_key, sizeof( binary_key ) );
+		ptr += sizeof( binary_key );
+	}
+
+	//  Tangent modes
+	for ( uint32_t i = 0; i < keys_count; i++ )
+	{
+		*ptr++ = (char)curve.get_tangent_mode( (int)i );
+	}
+
+	return data;
+}
+
+std::string CurveFile::get_extension( CurveFileFormat format )
+{
+	return format == CurveFileFormat::Binary 
+		? BINARY_EXTENSION 
+		: FORMAT_EXTENSION;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <curve-x/curve.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	enum class CurveFileFormat
+	{
+		//  Human-readable format, see CurveTextParser
+		Text,
+		//  Memory-mappable format, see BinaryCurveView
+		Binary,
+	};
+
+	/*
+	 * Reads & writes curve files in both formats, telling them apart
+	 * with the binary format's magic.
+	 */
+	class CurveFile
+	{
+	public:
+		//  Text files keep curve-x's FORMAT_EXTENSION, the binary 
+		//  ones having their own as 'cvxb' is taken by BakedCurve
+		static constexpr const char* BINARY_EXTENSION = "cvxbin";
+
+	public:
+		/*
+		 * Maps the file to read its curve, returning false if the
+		 * file can't be opened or is invalid, with the reason written
+		 * into the optional error (e.g. a text line & column).
+		 */
+		static bool load_from_file(
+			const std::string& path,
+			Curve* curve,
+			CurveFileFormat* format,
+			std::string* error = nullptr
+		);
+		static bool load_from_memory(
+			const void* data,
+			size_t size,
+			Curve* curve,
+			CurveFileFormat* format,
+			std::string* error = nullptr
+		);
+
+		/*
+		 * Writes the curve into a file, atomically replacing it, and
+		 * returns false if the file isn't writtable. Doesn't depend on
+		 * raylib so it can be called from any thread.
+		 */
+		static bool save_to_file(
+			const Curve& curve,
+			const std::string& path,
+			CurveFileFormat format
+		);
+
+		static std::vector<char> serialize_binary( const Curve& curve );
+
+		static std::string get_extension( CurveFileFormat format );
+	};
+}
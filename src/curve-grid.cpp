@@ -0,0 +1,93 @@
+#include "curve-grid.h"
+
+#include <src/settings.h>
+
+#include <cmath>
+
+using namespace curve_editor_x;
+
+void CurveGrid::set_visible_range( float visible_range )
+{
+	//  Subdivide visible range
+	const float gap = visible_range
+		/ ( settings::GRID_LARGE_COUNT * settings::GRID_SMALL_GAP );
+	if ( !( gap > 0.0f ) || !std::isfinite( gap ) ) return;
+
+	//  Get level power depending on zoom range, i.e. the exponent of
+	//  the gap's first significant digit
+	const int level_power = (int)floorf( log10f( gap ) );
+	const float exponent = powf( 10.0f, (float)level_power );
+
+	//  Snap grid gap to closest level
+	float closest_dist = INFINITY;
+	float closest_level = gap;
+	for ( float level : settings::GRID_LEVELS )
+	{
+		level *= exponent;
+
+		const float dist = fabsf( gap - level );
+		if ( dist < closest_dist )
+		{
+			closest_level = level;
+			closest_dist = dist;
+		}
+	}
+
+	//  Show as many decimals as the level's first digit
+	const int decimals = level_power < 0 ? -level_power : 0;
+
+	if ( closest_level == _gap && decimals == _decimals ) return;
+
+	_gap = closest_level;
+	_decimals = decimals;
+	_labels.clear();
+}
+
+CurveGridLines CurveGrid::find_lines_in( float min, float max ) const
+{
+	//  Ceiling instead of rounding fixes sudden lines appearing
+	CurveGridLines lines {};
+	lines.first_index = (int64_t)ceilf( min / _gap );
+	lines.last_index = (int64_t)ceilf( max / _gap ) - 1;
+	return lines;
+}
+
+bool CurveGrid::is_large_line( int64_t index ) const
+{
+	return index % (int64_t)settings::GRID_LARGE_COUNT == 0;
+}
+
+float CurveGrid::get_line_value( int64_t index ) const
+{
+	//  Multiplying instead of accumulating avoids drifting values
+	return (float)index * _gap;
+}
+
+const CurveGridLabel& CurveGrid::get_label( int64_t index, float font_size )
+{
+	const LabelKey key { index, font_size };
+
+	auto itr = _labels.find( key );
+	if ( itr != _labels.end() ) return itr->second;
+
+	//  Start over when full, e.g. after panning far away
+	if ( (int)_labels.size() >= settings::GRID_LABELS_CACHE_SIZE )
+	{
+		_labels.clear();
+	}
+
+	CurveGridLabel& label = _labels[key];
+	label.text = TextFormat( "%.*f", _decimals, get_line_value( index ) );
+	label.size = MeasureTextEx(
+		GetFontDefault(),
+		label.text.c_str(),
+		font_size,
+		settings::GRID_FONT_SPACING
+	);
+	return label;
+}
+
+float CurveGrid::get_gap() const
+{
+	return _gap;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+namespace curve_editor_x
+{
+	/*
+	 * Text of a grid line's value and its measured size.
+	 */
+	struct CurveGridLabel
+	{
+		std::string text {};
+		Vector2 size {};
+	};
+
+	/*
+	 * Indices of the grid lines inside the visible interval of an
+	 * axis, a line's value being its index multiplied by the gap.
+	 */
+	struct CurveGridLines
+	{
+		int64_t first_index = 0;
+		int64_t last_index = -1;
+	};
+
+	/*
+	 * Grid of the curve editor, snapping its gap on levels of the
+	 * visible range and caching the labels of its lines.
+	 *
+	 * Labels are kept across frames for the current level, so that
+	 * panning only formats & measures the lines entering the view.
+	 */
+	class CurveGrid
+	{
+	public:
+		/*
+		 * Snaps the gap to the closest level of the subdivided range,
+		 * dropping the labels if the level changed.
+		 */
+		void set_visible_range( float visible_range );
+		/*
+		 * Finds the lines inside the given interval.
+		 */
+		CurveGridLines find_lines_in( float min, float max ) const;
+
+		/*
+		 * Returns whether a line is a multiple of the large gap.
+		 */
+		bool is_large_line( int64_t index ) const;
+		float get_line_value( int64_t index ) const;
+		/*
+		 * Returns the label of a line, formatting and measuring it if
+		 * not cached.
+		 */
+		const CurveGridLabel& get_label( int64_t index, float font_size );
+
+		float get_gap() const;
+
+	private:
+		struct LabelKey
+		{
+			int64_t index;
+			float font_size;
+
+			bool operator==( const LabelKey& other ) const
+			{
+				return index == other.index && font_size == other.font_size;
+			}
+		};
+		struct LabelKeyHash
+		{
+			size_t operator()( const LabelKey& key ) const
+			{
+				return std::hash<int64_t>()( key.index )
+					^ ( std::hash<float>()( key.font_size ) << 1 );
+			}
+		};
+
+	private:
+		float _gap = 1.0f;
+		//  Number of decimals of the labels
+		int _decimals = 0;
+
+		//  Labels of the current gap & decimals
+		std::unordered_map<LabelKey, CurveGridLabel, LabelKeyHash> _labels {};
+	};
+}
@@ -0,0 +1,142 @@
+#include "curve-header-exporter.h"
+
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+using namespace curve_editor_x;
+
+std::string CurveHeaderExporter::generate(
+	const std::string& name,
+	const CurveTimeEvaluator& evaluator
+)
+{
+	const int segments_count = evaluator.get_segments_count();
+	const std::string identifier = sanitize_identifier( name );
+
+	std::ostringstream stream;
+	stream << "#pragma once\n"
+		   << "\n"
+		   << "//  Generated by Curve-X Editor from curve '" << name << "'.\n"
+		   << "//  Evaluate with: " << NAMESPACE << "::" << identifier
+		   << "::evaluate_by_time( time )\n"
+		   << "\n"
+		   << "namespace " << NAMESPACE << "\n"
+		   << "{\n"
+		   << "\tnamespace " << identifier << "\n"
+		   << "\t{\n";
+
+	//  Keys times
+	stream << "\t\tconstexpr int SEGMENTS_COUNT = " << segments_count << ";\n"
+		   << "\n"
+		   << "\t\t//  Time of each key\n"
+		   << "\t\tconstexpr float TIMES[SEGMENTS_COUNT + 1] {\n";
+	for ( int i = 0; i <= segments_count; i++ )
+	{
+		stream << "\t\t\t" << _format_float( evaluator.get_key_time( i ) )
+			   << ",\n";
+	}
+	stream << "\t\t};\n"
+		   << "\n";
+
+	//  Segments coefficients
+	stream << "\t\t//  Power-basis coefficients of each segment's Y-axis:\n"
+		   << "\t\t//  { a, b, c, d }\n"
+		   << "\t\tconstexpr float COEFFICIENTS[SEGMENTS_COUNT][4] {\n";
+	for ( int i = 0; i < segments_count; i++ )
+	{
+		float coefficients[4];
+		evaluator.get_segment_coefficients( i, coefficients );
+
+		stream << "\t\t\t{ ";
+		for ( int j = 0; j < 4; j++ )
+		{
+			stream << _format_float( coefficients[j] ) << ( j < 3 ? ", " : " " );
+		}
+		stream << "},\n";
+	}
+	stream << "\t\t};\n"
+		   << "\n";
+
+	//  Evaluation function, mirroring CurveTimeEvaluator
+	stream << R"(		/*
+		 * Evaluates the Y-value of the curve at the given time,
+		 * clamped to the first and last keys.
+		 */
+		constexpr float evaluate_by_time( float time )
+		{
+			//  Clamp to first & last keys
+			if ( time <= TIMES[0] ) return COEFFICIENTS[0][3];
+			if ( time >= TIMES[SEGMENTS_COUNT] )
+			{
+				const float* c = COEFFICIENTS[SEGMENTS_COUNT - 1];
+				return c[0] + c[1] + c[2] + c[3];
+			}
+
+			//  Binary search the segment containing the time
+			int first = 0;
+			int last = SEGMENTS_COUNT;
+			while ( last - first > 1 )
+			{
+				const int middle = ( first + last ) / 2;
+				if ( TIMES[middle] <= time )
+				{
+					first = middle;
+				}
+				else
+				{
+					last = middle;
+				}
+			}
+			const float* c = COEFFICIENTS[first];
+
+			//  Progress is linear between the keys' times, as curve-x
+			//  evaluates it
+			const float duration = TIMES[first + 1] - TIMES[first];
+			if ( duration <= 0.0f ) return c[3];
+
+			const float t = ( time - TIMES[first] ) / duration;
+			return ( ( c[0] * t + c[1] ) * t + c[2] ) * t + c[3];
+		}
+)";
+
+	stream << "\t}\n"
+		   << "}\n";
+	return stream.str();
+}
+
+std::string CurveHeaderExporter::sanitize_identifier( const std::string& name )
+{
+	//  Prefixed so it's never a keyword nor starts with a digit
+	std::string identifier = IDENTIFIER_PREFIX;
+	identifier.reserve( identifier.length() + name.length() );
+
+	for ( char character : name )
+	{
+		const char identifier_character = 
+			isalnum( (unsigned char)character ) ? character : '_';
+
+		//  Double underscores are reserved
+		if ( identifier_character == '_' && identifier.back() == '_' ) continue;
+
+		identifier += identifier_character;
+	}
+
+	return identifier;
+}
+
+std::string CurveHeaderExporter::_format_float( float value )
+{
+	//  Enough digits to round-trip a float
+	char buffer[32];
+	snprintf( buffer, sizeof( buffer ), "%.9g", value );
+
+	//  Ensure a valid float literal, '1f' isn't
+	std::string text = buffer;
+	if ( text.find_first_of( ".e" ) == std::string::npos )
+	{
+		text += ".0";
+	}
+
+	return text + "f";
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+
+#include <src/curve-time-evaluator.h>
+
+namespace curve_editor_x
+{
+	/*
+	 * Generates standalone C++17 headers embedding time-evaluated
+	 * curves, so they can be evaluated (or folded at compile-time)
+	 * without the curve-x library nor parsing files at startup.
+	 *
+	 * A generated header holds the keys times & segments coefficients
+	 * as 'constexpr' arrays and a 'constexpr' evaluation function
+	 * replicating CurveTimeEvaluator::evaluate_by_time, itself matching
+	 * curve-x's Curve::evaluate_by_time.
+	 */
+	class CurveHeaderExporter
+	{
+	public:
+		static constexpr const char* EXTENSION = "h";
+		static constexpr const char* NAMESPACE = "curve_x_generated";
+		static constexpr const char* IDENTIFIER_PREFIX = "curve_";
+
+	public:
+		/*
+		 * Returns the header's content, declaring the curve inside
+		 * a namespace named after the sanitized curve's name, e.g.
+		 * 'curve_default'.
+		 */
+		static std::string generate(
+			const std::string& name,
+			const CurveTimeEvaluator& evaluator
+		);
+
+		/*
+		 * Converts a name into a valid C++ identifier, always starting
+		 * with the prefix so it can't be a keyword.
+		 */
+		static std::string sanitize_identifier( const std::string& name );
+
+	private:
+		static std::string _format_float( float value );
+	};
+}
@@ -0,0 +1,93 @@
+#include "curve-importer.h"
+
+#include <src/trace.h>
+
+using namespace curve_editor_x;
+
+CurveImporter::CurveImporter( int threads_count )
+	: _pool( threads_count )
+{
+}
+
+void CurveImporter::import_files( const std::vector<std::string>& paths )
+{
+	std::lock_guard<std::mutex> lock( _mutex );
+
+	//  Start a new progress once everything has been collected
+	if ( !is_busy() )
+	{
+		_results.clear();
+		_loaded_results.clear();
+		_requested_count = 0;
+		_collected_count = 0;
+		_loaded_count = 0;
+	}
+
+	for ( const std::string& path : paths )
+	{
+		CurveImportResult result {};
+		result.path = path;
+		_results.push_back( std::move( result ) );
+		_loaded_results.push_back( false );
+
+		const int result_id = _requested_count++;
+		_pool.submit( [this, result_id] { 
+			_load_file( result_id ); 
+		} );
+	}
+}
+
+std::vector<CurveImportResult> CurveImporter::pop_results( int max_count )
+{
+	std::vector<CurveImportResult> results;
+
+	std::lock_guard<std::mutex> lock( _mutex );
+	while ( (int)results.size() < max_count
+	  && _collected_count < _requested_count
+	  && _loaded_results[_collected_count] )
+	{
+		results.push_back( std::move( _results[_collected_count] ) );
+		_collected_count++;
+	}
+
+	return results;
+}
+
+bool CurveImporter::is_busy() const
+{
+	return _collected_count < _requested_count;
+}
+
+int CurveImporter::get_requested_count() const
+{
+	return _requested_count;
+}
+
+int CurveImporter::get_loaded_count() const
+{
+	return _loaded_count;
+}
+
+void CurveImporter::_load_file( int result_id )
+{
+	TRACE_SCOPE( "CurveImporter::_load_file" );
+
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		path = _results[result_id].path;
+	}
+
+	//  Load outside of the lock, in parallel of other workers
+	CurveImportResult result {};
+	result.path = path;
+	result.is_success = CurveFile::load_from_file(
+		path, &result.curve, &result.format, &result.error );
+
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_results[result_id] = std::move( result );
+		_loaded_results[result_id] = true;
+	}
+	_loaded_count++;
+}
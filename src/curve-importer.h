@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <src/curve-file.h>
+#include <src/worker-pool.h>
+
+namespace curve_editor_x
+{
+	struct CurveImportResult
+	{
+		std::string path;
+		Curve curve {};
+		CurveFileFormat format = CurveFileFormat::Text;
+
+		bool is_success = false;
+		std::string error;
+	};
+
+	/*
+	 * Loads curve files in parallel on worker threads, the results
+	 * being collected by the main thread in batches, in the order the
+	 * files were requested.
+	 */
+	class CurveImporter
+	{
+	public:
+		CurveImporter( int threads_count = 0 );
+
+		/*
+		 * Queues the files to be loaded, adding to the current
+		 * progress if previous files are still loading.
+		 */
+		void import_files( const std::vector<std::string>& paths );
+		/*
+		 * Moves out up to 'max_count' loaded results, stopping at the
+		 * first file still loading to keep the requested order.
+		 */
+		std::vector<CurveImportResult> pop_results( int max_count );
+
+		/*
+		 * Returns whether some requested results haven't been
+		 * collected yet.
+		 */
+		bool is_busy() const;
+		int get_requested_count() const;
+		int get_loaded_count() const;
+
+	private:
+		void _load_file( int result_id );
+
+	private:
+		//  Main thread only
+		int _requested_count = 0;
+		int _collected_count = 0;
+
+		std::atomic<int> _loaded_count { 0 };
+
+		//  Guards results and their loaded states
+		std::mutex _mutex {};
+		std::vector<CurveImportResult> _results {};
+		std::vector<bool> _loaded_results {};
+
+		//  Last member to be destroyed first, stopping the workers
+		//  before the results are released
+		WorkerPool _pool;
+	};
+}
@@ -0,0 +1,73 @@
+#include "curve-key-markers.h"
+
+using namespace curve_editor_x;
+
+void CurveKeyMarkers::rebuild( const Curve& curve )
+{
+	const int keys_count = curve.get_keys_count();
+
+	_markers.resize( keys_count );
+	for ( int i = 0; i < keys_count; i++ )
+	{
+		_compute_marker( curve, i );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveKeyMarkers::update( const Curve& curve )
+{
+	const int keys_count = curve.get_keys_count();
+
+	//  Keys have been added or removed, markers are shifted
+	if ( _dirty_range.is_fully_dirty
+	  || keys_count != (int)_markers.size() )
+	{
+		rebuild( curve );
+		return;
+	}
+	if ( !_dirty_range.is_dirty() ) return;
+
+	for ( int i = _dirty_range.first_key_id; i <= _dirty_range.last_key_id; i++ )
+	{
+		_compute_marker( curve, i );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveKeyMarkers::invalidate()
+{
+	_dirty_range.invalidate();
+}
+
+void CurveKeyMarkers::invalidate_key( int key_id )
+{
+	_dirty_range.invalidate_key( key_id );
+}
+
+bool CurveKeyMarkers::is_dirty() const
+{
+	return _dirty_range.is_dirty();
+}
+
+const CurveKeyMarker& CurveKeyMarkers::get_marker( int key_id ) const
+{
+	return _markers[key_id];
+}
+
+int CurveKeyMarkers::get_markers_count() const
+{
+	return (int)_markers.size();
+}
+
+void CurveKeyMarkers::_compute_marker( const Curve& curve, int key_id )
+{
+	const CurveKey& key = curve.get_key( key_id );
+
+	CurveKeyMarker& marker = _markers[key_id];
+	marker.control = key.control;
+	marker.left_tangent = key.control + key.left_tangent;
+	marker.right_tangent = key.control + key.right_tangent;
+	marker.tangent_mode = curve.get_tangent_mode( key_id );
+}
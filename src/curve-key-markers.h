@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/dirty-key-range.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Curve-space positions of a key's points and its tangent mode.
+	 */
+	struct CurveKeyMarker
+	{
+		Point control {};
+		//  Global positions of the tangents
+		Point left_tangent {};
+		Point right_tangent {};
+		TangentMode tangent_mode = TangentMode::Mirrored;
+	};
+
+	/*
+	 * Editor markers of all keys of a curve, so that drawing them
+	 * doesn't query the curve for each point.
+	 */
+	class CurveKeyMarkers
+	{
+	public:
+		/*
+		 * Re-computes the markers of all keys.
+		 */
+		void rebuild( const Curve& curve );
+		/*
+		 * Re-computes the markers of the keys invalidated since the
+		 * last update, or all of them if entirely invalidated.
+		 */
+		void update( const Curve& curve );
+
+		/*
+		 * Invalidates the whole markers.
+		 */
+		void invalidate();
+		void invalidate_key( int key_id );
+		bool is_dirty() const;
+
+		const CurveKeyMarker& get_marker( int key_id ) const;
+		int get_markers_count() const;
+
+	private:
+		void _compute_marker( const Curve& curve, int key_id );
+
+	private:
+		std::vector<CurveKeyMarker> _markers {};
+
+		DirtyKeyRange _dirty_range {};
+	};
+}
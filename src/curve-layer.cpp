@@ -0,0 +1,155 @@
+#include "curve-layer.h"
+
+#include <src/profiler.h>
+
+#include <cstdio>
+
+using namespace curve_editor_x;
+
+void CurveLayer::mark_dirty()
+{
+	has_unsaved_changes = true;
+	revision++;
+
+	_invalidate_caches();
+}
+
+void CurveLayer::mark_key_dirty( int key_id )
+{
+	has_unsaved_changes = true;
+	revision++;
+
+	_tessellation.invalidate_key( key_id );
+	_arc_length_table.invalidate_key( key_id );
+	_segment_tree.invalidate_key( key_id );
+	_time_evaluator.invalidate_key( key_id );
+	_key_markers.invalidate_key( key_id );
+}
+
+void CurveLayer::set_pack_entry( ref<CurvePack> pack, int entry_id )
+{
+	this->pack = pack;
+	pack_entry_id = entry_id;
+	_pack_extrems = pack->get_entry_extrems( entry_id );
+
+	curve = Curve {};
+	_is_loaded = false;
+}
+
+void CurveLayer::load()
+{
+	if ( _is_loaded ) return;
+	_is_loaded = true;
+
+	ProfilerScope scope( "Curve decoding" );
+	if ( !pack->decode( pack_entry_id, &curve ) )
+	{
+		printf( "Curve '%s' of pack '%s' is invalid, failed to decode it!\n",
+			name.c_str(), pack->get_path().c_str() );
+	}
+
+	//  Caches can't have been built before, but keep them coherent
+	_invalidate_caches();
+}
+
+bool CurveLayer::is_loaded() const
+{
+	return _is_loaded;
+}
+
+CurveExtrems CurveLayer::get_extrems()
+{
+	if ( !_is_loaded ) return _pack_extrems;
+	if ( !curve.is_valid() ) return CurveExtrems {};
+
+	return curve.get_extrems();
+}
+
+CurveTessellation& CurveLayer::get_tessellation( const Point& scale )
+{
+	if ( _tessellation.is_dirty( scale ) )
+	{
+		_tessellation.update( curve, scale );
+	}
+
+	//  Segments tessellated on demand since the last call
+	Profiler::add_count( "Evaluated samples", 
+		_tessellation.pop_tessellated_points_count() );
+
+	return _tessellation;
+}
+
+const std::vector<Point>& CurveLayer::get_time_samples(
+	float min_time,
+	float max_time,
+	int samples_count
+)
+{
+	if ( _time_samples.is_dirty( revision, min_time, max_time, samples_count ) )
+	{
+		ProfilerScope scope( "Curve evaluation" );
+		_time_samples.rebuild(
+			get_time_evaluator(),
+			revision,
+			min_time,
+			max_time,
+			samples_count
+		);
+		Profiler::add_count( "Evaluated samples", 
+			(int)_time_samples.get_points().size() );
+	}
+
+	return _time_samples.get_points();
+}
+
+const CurveArcLengthTable& CurveLayer::get_arc_length_table()
+{
+	if ( _arc_length_table.is_dirty() )
+	{
+		ProfilerScope scope( "Curve evaluation" );
+		_arc_length_table.update( curve );
+	}
+
+	return _arc_length_table;
+}
+
+const CurveSegmentTree& CurveLayer::get_segment_tree()
+{
+	if ( _segment_tree.is_dirty() )
+	{
+		ProfilerScope scope( "Curve evaluation" );
+		_segment_tree.update( curve );
+	}
+
+	return _segment_tree;
+}
+
+const CurveTimeEvaluator& CurveLayer::get_time_evaluator()
+{
+	if ( _time_evaluator.is_dirty() )
+	{
+		ProfilerScope scope( "Curve evaluation" );
+		_time_evaluator.update( curve );
+	}
+
+	return _time_evaluator;
+}
+
+const CurveKeyMarkers& CurveLayer::get_key_markers()
+{
+	if ( _key_markers.is_dirty() )
+	{
+		_key_markers.update( curve );
+	}
+
+	return _key_markers;
+}
+
+void CurveLayer::_invalidate_caches()
+{
+	_tessellation.invalidate();
+	_arc_length_table.invalidate();
+	_segment_tree.invalidate();
+	_time_evaluator.invalidate();
+	_key_markers.invalidate();
+}
@@ -3,10 +3,40 @@
 #include <raylib.h>
 #include <curve-x/curve.h>
 
+#include <src/polyline-stroke.h>
+#include <src/curve-stroke-mesh.h>
+#include <src/curve-tessellation.h>
+#include <src/curve-arc-length-table.h>
+#include <src/curve-segment-tree.h>
+#include <src/curve-time-evaluator.h>
+#include <src/curve-time-samples.h>
+#include <src/curve-key-markers.h>
+#include <src/curve-file.h>
+#include <src/curve-pack.h>
+#include <src/usings.h>
+
 namespace curve_editor_x
 {
 	using namespace curve_x;
 
+	/*
+	 * Strokes of a curve layer, kept until the curve, the view or the
+	 * stroke's style changes.
+	 */
+	struct CurveStrokeCache
+	{
+		//  Visible parts of the curve, rebuilt on any view change
+		PolylineStroke stroke {};
+
+		int revision = -1;
+		int view_revision = -1;
+		CurveInterpolateMode mode = CurveInterpolateMode::MAX;
+		float thickness = 0.0f;
+
+		//  Whole curve, only rebuilt on zoom changes
+		CurveStrokeMesh mesh {};
+	};
+
 	struct CurveLayer
 	{
 	public:
@@ -14,6 +44,69 @@ namespace curve_editor_x
 		CurveLayer( const Curve& curve )
 			: curve( curve ) {}
 
+		/*
+		 * Flags the curve as edited: marks the layer as having unsaved
+		 * changes and invalidates all of its cached data.
+		 */
+		void mark_dirty();
+		/*
+		 * Flags a single key of the curve as edited, allowing cached
+		 * data to only update the segments around it.
+		 */
+		void mark_key_dirty( int key_id );
+
+		/*
+		 * Links the layer to a packed curve, decoded on the first
+		 * call to 'load'.
+		 */
+		void set_pack_entry( ref<CurvePack> pack, int entry_id );
+		/*
+		 * Decodes the curve from its pack if not loaded yet.
+		 */
+		void load();
+		bool is_loaded() const;
+		/*
+		 * Returns the curve's extrems, copied from the pack's table
+		 * of contents until the curve is loaded.
+		 */
+		CurveExtrems get_extrems();
+
+		/*
+		 * Returns the curve-space polylines of the curve's segments
+		 * for the given screen scale (pixels per curve unit), 
+		 * tessellated once requested.
+		 */
+		CurveTessellation& get_tessellation( const Point& scale );
+		/*
+		 * Returns the time-evaluated samples of the curve between the 
+		 * given times, re-sampling it if out-of-date.
+		 */
+		const std::vector<Point>& get_time_samples(
+			float min_time,
+			float max_time,
+			int samples_count
+		);
+		/*
+		 * Returns the arc-length table of the curve, re-measuring its
+		 * edited segments if out-of-date.
+		 */
+		const CurveArcLengthTable& get_arc_length_table();
+		/*
+		 * Returns the segments bounding-box hierarchy of the curve,
+		 * refitting its edited segments if out-of-date.
+		 */
+		const CurveSegmentTree& get_segment_tree();
+		/*
+		 * Returns the time-evaluator of the curve, recomputing its
+		 * edited segments if out-of-date.
+		 */
+		const CurveTimeEvaluator& get_time_evaluator();
+		/*
+		 * Returns the editor markers of the curve's keys, recomputing
+		 * its edited keys if out-of-date.
+		 */
+		const CurveKeyMarkers& get_key_markers();
+
 	public:
 		std::string name = "default";
 		std::string path = "default.cvx";
@@ -24,5 +117,32 @@ namespace curve_editor_x
 
 		bool has_unsaved_changes = true;
 		bool is_file_exists = false;
+		//  Format of the file, kept when saving
+		CurveFileFormat file_format = CurveFileFormat::Text;
+		//  Pack holding the curve, saved instead of the file if set
+		ref<CurvePack> pack = nullptr;
+		int pack_entry_id = -1;
+
+		//  Incremented each time the curve is edited
+		int revision = 0;
+
+		//  Stroke of the curve, rebuilt by the editor when out-of-date
+		CurveStrokeCache stroke_cache {};
+
+	private:
+		void _invalidate_caches();
+
+	private:
+		bool _is_loaded = true;
+		//  Read once linked, so the pack isn't accessed every frame
+		CurveExtrems _pack_extrems {};
+
+		CurveTessellation _tessellation {};
+		CurveTimeSamples _time_samples {};
+
+		CurveArcLengthTable _arc_length_table {};
+		CurveSegmentTree _segment_tree {};
+		CurveTimeEvaluator _time_evaluator {};
+		CurveKeyMarkers _key_markers {};
 	};
-}
\ No newline at end of file
+}
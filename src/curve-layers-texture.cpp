@@ -0,0 +1,131 @@
+#include "curve-layers-texture.h"
+
+#include <rlgl.h>
+
+#include <src/profiler.h>
+
+using namespace curve_editor_x;
+
+CurveLayersTexture::~CurveLayersTexture()
+{
+	unload();
+}
+
+bool CurveLayersTexture::is_dirty(
+	const std::vector<CurveLayerSignature>& signatures,
+	int view_revision,
+	CurveInterpolateMode mode,
+	float thickness,
+	const Rectangle& frame
+) const
+{
+	if ( !_is_loaded
+	  || _view_revision != view_revision
+	  || _mode != mode
+	  || _thickness != thickness
+	  || _frame.x != frame.x || _frame.y != frame.y
+	  || _frame.width != frame.width || _frame.height != frame.height
+	  || _signatures.size() != signatures.size() ) return true;
+
+	for ( int i = 0; i < (int)signatures.size(); i++ )
+	{
+		const CurveLayerSignature& a = _signatures[i];
+		const CurveLayerSignature& b = signatures[i];
+		if ( a.layer != b.layer
+		  || a.revision != b.revision
+		  || a.color.r != b.color.r || a.color.g != b.color.g
+		  || a.color.b != b.color.b || a.color.a != b.color.a ) return true;
+	}
+
+	return false;
+}
+
+void CurveLayersTexture::begin(
+	const std::vector<CurveLayerSignature>& signatures,
+	int view_revision,
+	CurveInterpolateMode mode,
+	float thickness,
+	const Rectangle& frame
+)
+{
+	const int width = (int)frame.width;
+	const int height = (int)frame.height;
+
+	//  Re-load on resize
+	if ( _is_loaded
+	  && ( _texture.texture.width != width
+		|| _texture.texture.height != height ) )
+	{
+		unload();
+	}
+	if ( !_is_loaded )
+	{
+		_texture = LoadRenderTexture( width, height );
+		_is_loaded = true;
+	}
+
+	_signatures = signatures;
+	_view_revision = view_revision;
+	_mode = mode;
+	_thickness = thickness;
+	_frame = frame;
+
+	BeginTextureMode( _texture );
+	ClearBackground( BLANK );
+
+	//  Accumulate premultiplied colors: the texture's alpha is the
+	//  coverage of all layers instead of being blended with itself
+	rlSetBlendFactorsSeparate(
+		RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA,
+		RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+		RL_FUNC_ADD, RL_FUNC_ADD
+	);
+	BeginBlendMode( BLEND_CUSTOM_SEPARATE );
+
+	//  Offset screen-space drawing into the texture
+	rlPushMatrix();
+	rlTranslatef( -frame.x, -frame.y, 0.0f );
+}
+
+void CurveLayersTexture::end()
+{
+	rlPopMatrix();
+	EndBlendMode();
+	EndTextureMode();
+}
+
+void CurveLayersTexture::unload()
+{
+	if ( _is_loaded )
+	{
+		UnloadRenderTexture( _texture );
+		_texture = RenderTexture2D {};
+		_is_loaded = false;
+	}
+
+	_signatures.clear();
+	_view_revision = -1;
+}
+
+void CurveLayersTexture::render() const
+{
+	if ( !_is_loaded ) return;
+
+	ProfilerScope scope( "Draw submission" );
+
+	//  Render textures are flipped vertically
+	BeginBlendMode( BLEND_ALPHA_PREMULTIPLY );
+	DrawTextureRec(
+		_texture.texture,
+		Rectangle {
+			0.0f,
+			0.0f,
+			(float)_texture.texture.width,
+			-(float)_texture.texture.height,
+		},
+		Vector2 { _frame.x, _frame.y },
+		WHITE
+	);
+	EndBlendMode();
+	Profiler::add_count( "Draw submissions", 1 );
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+
+#include <src/curve-interpolate-mode.h>
+
+namespace curve_editor_x
+{
+	class CurveLayer;
+
+	/*
+	 * State of a layer drawn into a CurveLayersTexture.
+	 */
+	struct CurveLayerSignature
+	{
+		const CurveLayer* layer = nullptr;
+		int revision = -1;
+		Color color {};
+	};
+
+	/*
+	 * Render texture compositing several curve layers, kept until one
+	 * of them, the view or the stroke's style changes.
+	 *
+	 * Layers are blended into a premultiplied texture so that it can
+	 * be drawn over the screen as if each layer was drawn directly.
+	 *
+	 * Requires the window to be opened while drawing or unloading.
+	 */
+	class CurveLayersTexture
+	{
+	public:
+		CurveLayersTexture() {}
+		CurveLayersTexture( const CurveLayersTexture& ) = delete;
+		CurveLayersTexture& operator=( const CurveLayersTexture& ) = delete;
+		~CurveLayersTexture();
+
+		bool is_dirty(
+			const std::vector<CurveLayerSignature>& signatures,
+			int view_revision,
+			CurveInterpolateMode mode,
+			float thickness,
+			const Rectangle& frame
+		) const;
+
+		/*
+		 * Starts drawing into the texture, (re-)loading it if the
+		 * frame's size changed. Drawing is still done in screen-space.
+		 * Must not be called inside a scissor mode.
+		 */
+		void begin(
+			const std::vector<CurveLayerSignature>& signatures,
+			int view_revision,
+			CurveInterpolateMode mode,
+			float thickness,
+			const Rectangle& frame
+		);
+		void end();
+
+		/*
+		 * Releases the GPU resources, the texture is then dirty.
+		 */
+		void unload();
+
+		/*
+		 * Draws the texture at its frame.
+		 */
+		void render() const;
+
+	private:
+		RenderTexture2D _texture {};
+		bool _is_loaded = false;
+
+		std::vector<CurveLayerSignature> _signatures {};
+		int _view_revision = -1;
+		CurveInterpolateMode _mode = CurveInterpolateMode::MAX;
+		float _thickness = 0.0f;
+		Rectangle _frame {};
+	};
+}
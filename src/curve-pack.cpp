@@ -0,0 +1,361 @@
+#include "curve-pack.h"
+
+#include <src/atomic-file.h>
+#include <src/binary-curve.h>
+#include <src/curve-file.h>
+#include <src/trace.h>
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+using namespace curve_editor_x;
+
+static bool flush_to_disk( FILE* file )
+{
+	if ( fflush( file ) != 0 ) return false;
+
+#ifdef _WIN32
+	return _commit( _fileno( file ) ) == 0;
+#else
+	return fsync( fileno( file ) ) == 0;
+#endif
+}
+
+static void pad_to_alignment( std::vector<char>* data, uint64_t base_offset )
+{
+	while ( ( base_offset + data->size() ) % CurvePack::BLOB_ALIGNMENT != 0 )
+	{
+		data->push_back( 0 );
+	}
+}
+
+bool CurvePack::open( const std::string& path )
+{
+	TRACE_SCOPE( "CurvePack::open" );
+
+	_path = path;
+	return _map();
+}
+
+bool CurvePack::save( const std::vector<CurvePackItem>& items )
+{
+	TRACE_SCOPE( "CurvePack::save" );
+
+	if ( !_file.is_open() || !_are_items_valid( items, this ) ) return false;
+
+	bool is_success = false;
+	if ( _should_compact( items ) )
+	{
+		const std::vector<char> data = _build( items, this );
+
+		//  Windows can't replace a mapped file
+		_file.close();
+		is_success = AtomicFile::write( _path, data.data(), data.size() );
+	}
+	else
+	{
+		is_success = _append( items );
+	}
+
+	//  Map the new table of contents, or the previous one on failure
+	return _map() && is_success;
+}
+
+bool CurvePack::create(
+	const std::string& path,
+	const std::vector<CurvePackItem>& items
+)
+{
+	TRACE_SCOPE( "CurvePack::create" );
+
+	if ( !_are_items_valid( items, nullptr ) ) return false;
+
+	const std::vector<char> data = _build( items, nullptr );
+	return AtomicFile::write( path, data.data(), data.size() );
+}
+
+bool CurvePack::decode( int entry_id, Curve* curve ) const
+{
+	TRACE_SCOPE( "CurvePack::decode" );
+
+	if ( entry_id < 0 || entry_id >= get_entries_count() ) return false;
+
+	const CurvePackEntry& entry = _entries[entry_id];
+	const char* data = (const char*)_file.get_data() + entry.offset;
+
+	CurveFileFormat format;
+	return CurveFile::load_from_memory( data, entry.size, curve, &format )
+		&& format == CurveFileFormat::Binary;
+}
+
+int CurvePack::get_entries_count() const
+{
+	return (int)_entries.size();
+}
+
+const CurvePackEntry& CurvePack::get_entry( int entry_id ) const
+{
+	return _entries[entry_id];
+}
+
+std::string CurvePack::get_entry_name( int entry_id ) const
+{
+	const CurvePackEntry& entry = _entries[entry_id];
+	return _names.substr( entry.name_offset, entry.name_size );
+}
+
+CurveExtrems CurvePack::get_entry_extrems( int entry_id ) const
+{
+	const CurvePackEntry& entry = _entries[entry_id];
+
+	CurveExtrems extrems {};
+	extrems.min_x = entry.min_x;
+	extrems.max_x = entry.max_x;
+	extrems.min_y = entry.min_y;
+	extrems.max_y = entry.max_y;
+	return extrems;
+}
+
+const std::string& CurvePack::get_path() const
+{
+	return _path;
+}
+
+bool CurvePack::_map()
+{
+	_entries.clear();
+	_names.clear();
+
+	if ( !_file.open( _path ) ) return false;
+	if ( !_read_table_of_contents() )
+	{
+		_entries.clear();
+		_names.clear();
+		_file.close();
+		return false;
+	}
+
+	return true;
+}
+
+bool CurvePack::_read_table_of_contents()
+{
+	const char* data = (const char*)_file.get_data();
+	const uint64_t size = _file.get_size();
+
+	CurvePackHeader header {};
+	if ( size < sizeof( header ) ) return false;
+	memcpy( &header, data, sizeof( header ) );
+
+	if ( memcmp( header.magic, CurvePackHeader().magic, sizeof( header.magic ) ) != 0
+	  || header.version != CurvePackHeader().version ) return false;
+
+	//  Table of contents within the file
+	const uint64_t entries_size =
+		(uint64_t)header.entries_count * sizeof( CurvePackEntry );
+	if ( header.toc_offset > size
+	  || entries_size + header.names_size > size - header.toc_offset )
+		return false;
+
+	const char* toc = data + header.toc_offset;
+	_entries.resize( header.entries_count );
+	memcpy( _entries.data(), toc, entries_size );
+	_names.assign( toc + entries_size, header.names_size );
+
+	//  Blobs & names within their tables
+	for ( const CurvePackEntry& entry : _entries )
+	{
+		if ( entry.offset > header.toc_offset
+		  || entry.size > header.toc_offset - entry.offset
+		  || entry.offset % BLOB_ALIGNMENT != 0
+		  || entry.name_offset > header.names_size
+		  || entry.name_size > header.names_size - entry.name_offset )
+			return false;
+	}
+
+	return true;
+}
+
+bool CurvePack::_are_items_valid(
+	const std::vector<CurvePackItem>& items,
+	const CurvePack* pack
+)
+{
+	for ( const CurvePackItem& item : items )
+	{
+		if ( item.curve != nullptr ) continue;
+
+		//  Unchanged curves are copied from the pack's entries
+		if ( pack == nullptr
+		  || item.entry_id < 0
+		  || item.entry_id >= pack->get_entries_count() )
+			return false;
+	}
+
+	return true;
+}
+
+bool CurvePack::_append( const std::vector<CurvePackItem>& items )
+{
+	const uint64_t base_offset = _file.get_size();
+
+	//  Changed curves, appended after the current content
+	std::vector<char> data;
+	std::vector<CurvePackEntry> entries;
+	entries.reserve( items.size() );
+	for ( const CurvePackItem& item : items )
+	{
+		if ( item.curve == nullptr )
+		{
+			entries.push_back( _entries[item.entry_id] );
+			continue;
+		}
+
+		pad_to_alignment( &data, base_offset );
+
+		const std::vector<char> blob = CurveFile::serialize_binary( *item.curve );
+		CurvePackEntry entry = _make_entry( *item.curve );
+		entry.offset = base_offset + data.size();
+		entry.size = (uint32_t)blob.size();
+		entries.push_back( entry );
+
+		data.insert( data.end(), blob.begin(), blob.end() );
+	}
+
+	CurvePackHeader header {};
+	_write_table_of_contents( items, entries, base_offset, &data, &header );
+
+	//  Windows can't write into a mapped file
+	_file.close();
+
+	FILE* file = fopen( _path.c_str(), "r+b" );
+	if ( file == nullptr ) return false;
+
+	//  The new table must be on the disk before the header points
+	//  to it
+	bool is_success = fseek( file, 0, SEEK_END ) == 0
+		&& fwrite( data.data(), 1, data.size(), file ) == data.size()
+		&& flush_to_disk( file );
+	is_success = is_success
+		&& fseek( file, 0, SEEK_SET ) == 0
+		&& fwrite( &header, sizeof( header ), 1, file ) == 1
+		&& flush_to_disk( file );
+
+	return fclose( file ) == 0 && is_success;
+}
+
+bool CurvePack::_should_compact( const std::vector<CurvePackItem>& items ) const
+{
+	//  Bytes still referenced once saved
+	uint64_t used_size = sizeof( CurvePackHeader );
+	uint64_t unchanged_size = sizeof( CurvePackHeader );
+	for ( const CurvePackItem& item : items )
+	{
+		if ( item.curve == nullptr )
+		{
+			used_size += _entries[item.entry_id].size;
+			unchanged_size += _entries[item.entry_id].size;
+		}
+		else
+		{
+			used_size += BinaryCurveView::get_data_size(
+				(uint32_t)item.curve->get_keys_count() );
+		}
+	}
+
+	//  Replaced blobs & previous tables of contents
+	const uint64_t unused_size = _file.get_size() - unchanged_size;
+	return unused_size > used_size;
+}
+
+std::vector<char> CurvePack::_build(
+	const std::vector<CurvePackItem>& items,
+	const CurvePack* pack
+)
+{
+	std::vector<char> data( sizeof( CurvePackHeader ) );
+	std::vector<CurvePackEntry> entries;
+	entries.reserve( items.size() );
+	for ( const CurvePackItem& item : items )
+	{
+		pad_to_alignment( &data, 0 );
+
+		CurvePackEntry entry {};
+		if ( item.curve == nullptr )
+		{
+			//  Copy the packed blob as-is
+			entry = pack->_entries[item.entry_id];
+
+			const char* blob = (const char*)pack->_file.get_data() + entry.offset;
+			entry.offset = data.size();
+			data.insert( data.end(), blob, blob + entry.size );
+		}
+		else
+		{
+			const std::vector<char> blob = CurveFile::serialize_binary( *item.curve );
+			entry = _make_entry( *item.curve );
+			entry.offset = data.size();
+			entry.size = (uint32_t)blob.size();
+			data.insert( data.end(), blob.begin(), blob.end() );
+		}
+		entries.push_back( entry );
+	}
+
+	CurvePackHeader header {};
+	_write_table_of_contents( items, entries, 0, &data, &header );
+	memcpy( data.data(), &header, sizeof( header ) );
+
+	return data;
+}
+
+CurvePackEntry CurvePack::_make_entry( const Curve& curve )
+{
+	CurvePackEntry entry {};
+	entry.keys_count = (uint32_t)curve.get_keys_count();
+
+	if ( curve.is_valid() )
+	{
+		const CurveExtrems extrems = curve.get_extrems();
+		entry.min_x = extrems.min_x;
+		entry.max_x = extrems.max_x;
+		entry.min_y = extrems.min_y;
+		entry.max_y = extrems.max_y;
+	}
+
+	return entry;
+}
+
+void CurvePack::_write_table_of_contents(
+	const std::vector<CurvePackItem>& items,
+	std::vector<CurvePackEntry>& entries,
+	uint64_t base_offset,
+	std::vector<char>* data,
+	CurvePackHeader* header
+)
+{
+	pad_to_alignment( data, base_offset );
+
+	//  Names table
+	std::string names;
+	for ( size_t i = 0; i < items.size(); i++ )
+	{
+		entries[i].name_offset = (uint32_t)names.size();
+		entries[i].name_size = (uint32_t)items[i].name.size();
+		names += items[i].name;
+	}
+
+	header->toc_offset = base_offset + data->size();
+	header->entries_count = (uint32_t)entries.size();
+	header->names_size = (uint32_t)names.size();
+
+	const char* entries_data = (const char*)entries.data();
+	data->insert( data->end(),
+		entries_data, entries_data + entries.size() * sizeof( CurvePackEntry ) );
+	data->insert( data->end(), names.begin(), names.end() );
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/mapped-file.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	struct CurvePackHeader
+	{
+		char magic[4] { 'C', 'X', 'P', 'K' };
+		uint16_t version = 1;
+		uint16_t reserved = 0;
+		uint64_t toc_offset = 0;
+		uint32_t entries_count = 0;
+		uint32_t names_size = 0;
+	};
+
+	/*
+	 * Table of contents' entry, describing a packed curve well enough
+	 * to list and cull it without decoding its keys.
+	 */
+	struct CurvePackEntry
+	{
+		//  Binary curve blob, see BinaryCurveView
+		uint64_t offset = 0;
+		uint32_t size = 0;
+		uint32_t keys_count = 0;
+
+		float min_x = 0.0f, max_x = 0.0f;
+		float min_y = 0.0f, max_y = 0.0f;
+
+		//  Name inside the names table, following the entries
+		uint32_t name_offset = 0;
+		uint32_t name_size = 0;
+	};
+
+	static_assert( sizeof( CurvePackHeader ) == 24, "Unexpected padding" );
+	static_assert( sizeof( CurvePackEntry ) == 40, "Unexpected padding" );
+
+	/*
+	 * Curve to write into a pack, in the order of the new table of
+	 * contents.
+	 */
+	struct CurvePackItem
+	{
+		std::string name;
+		//  Entry of the curve in the pack, -1 if not packed yet
+		int entry_id = -1;
+		//  Curve to write, nullptr to keep the packed one as-is
+		const Curve* curve = nullptr;
+	};
+
+	/*
+	 * Archive of named curves, holding packed binary curves followed
+	 * by a table of contents:
+	 * - CurvePackHeader, pointing to the table of contents
+	 * - binary curve blobs, 8-bytes aligned
+	 * - 'entries_count' CurvePackEntry, then the names table
+	 *
+	 * Opening only reads the table of contents, curves being decoded
+	 * from the mapped file on demand.
+	 *
+	 * Saving appends the changed curves and a new table of contents
+	 * before pointing the header to it, so a crash leaves the previous
+	 * table valid. Once unused blobs take most of the file, it's
+	 * compacted by rewriting it whole.
+	 *
+	 * A pack isn't thread-safe: while it's saved on another thread,
+	 * nothing else may access it (see CurveSaver).
+	 */
+	class CurvePack
+	{
+	public:
+		static constexpr const char* EXTENSION = "cvxpack";
+		static constexpr size_t BLOB_ALIGNMENT = 8;
+
+	public:
+		CurvePack() {}
+		CurvePack( const CurvePack& ) = delete;
+		CurvePack& operator=( const CurvePack& ) = delete;
+
+		/*
+		 * Maps the file and reads its table of contents, returning
+		 * false if it can't be opened or is invalid.
+		 */
+		bool open( const std::string& path );
+		/*
+		 * Writes the items as a new table of contents, curves not
+		 * being packed yet requiring a curve. The items' entries ids
+		 * then become their indexes. Returns false without writing if
+		 * an item has neither a curve nor a valid entry.
+		 */
+		bool save( const std::vector<CurvePackItem>& items );
+		/*
+		 * Writes a new pack made of the items, which all require a
+		 * curve.
+		 */
+		static bool create(
+			const std::string& path,
+			const std::vector<CurvePackItem>& items
+		);
+
+		/*
+		 * Decodes the keys of a packed curve.
+		 */
+		bool decode( int entry_id, Curve* curve ) const;
+
+		int get_entries_count() const;
+		const CurvePackEntry& get_entry( int entry_id ) const;
+		std::string get_entry_name( int entry_id ) const;
+		CurveExtrems get_entry_extrems( int entry_id ) const;
+		const std::string& get_path() const;
+
+	private:
+		bool _map();
+		bool _read_table_of_contents();
+		static bool _are_items_valid(
+			const std::vector<CurvePackItem>& items,
+			const CurvePack* pack
+		);
+		bool _append( const std::vector<CurvePackItem>& items );
+		bool _should_compact( const std::vector<CurvePackItem>& items ) const;
+
+		/*
+		 * Serializes a whole pack of the items, copying the blobs of
+		 * unchanged curves from this pack if given.
+		 */
+		static std::vector<char> _build(
+			const std::vector<CurvePackItem>& items,
+			const CurvePack* pack
+		);
+		static CurvePackEntry _make_entry( const Curve& curve );
+		static void _write_table_of_contents(
+			const std::vector<CurvePackItem>& items,
+			std::vector<CurvePackEntry>& entries,
+			uint64_t base_offset,
+			std::vector<char>* data,
+			CurvePackHeader* header
+		);
+
+	private:
+		std::string _path;
+		MappedFile _file;
+
+		std::vector<CurvePackEntry> _entries;
+		std::string _names;
+	};
+}
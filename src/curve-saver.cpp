@@ -0,0 +1,144 @@
+#include "curve-saver.h"
+
+#include <src/trace.h>
+
+#include <algorithm>
+
+using namespace curve_editor_x;
+
+void CurveSaver::save( ref<CurveLayer> layer, const std::string& path )
+{
+	TRACE_SCOPE( "CurveSaver::save" );
+
+	CurveSaveResult result {};
+	result.layer = layer;
+	result.path = path;
+	result.revision = layer->revision;
+
+	_pending_count++;
+	_pool.submit( 
+		[this, result, curve = layer->curve, format = layer->file_format]() mutable 
+		{
+			result.is_success = CurveFile::save_to_file( 
+				curve, result.path, format );
+
+			std::lock_guard<std::mutex> lock( _mutex );
+			_results.push_back( std::move( result ) );
+			_condition.notify_all();
+		} 
+	);
+}
+
+void CurveSaver::save_pack( 
+	ref<CurvePack> pack, 
+	const std::vector<ref<CurveLayer>>& layers 
+)
+{
+	TRACE_SCOPE( "CurveSaver::save_pack" );
+
+	//  Snapshot of the items, changed curves being copied
+	struct Snapshot
+	{
+		std::vector<CurvePackItem> items;
+		std::vector<Curve> curves;
+		std::vector<int> curve_ids;
+	};
+	auto snapshot = std::make_shared<Snapshot>();
+
+	CurvePackSaveResult result {};
+	result.pack = pack;
+	for ( const ref<CurveLayer>& layer : layers )
+	{
+		CurvePackItem item {};
+		item.name = layer->name;
+		item.entry_id = layer->pack_entry_id;
+		snapshot->items.push_back( item );
+
+		int curve_id = -1;
+		if ( layer->is_loaded() 
+		  && ( layer->has_unsaved_changes || layer->pack_entry_id < 0 ) )
+		{
+			curve_id = (int)snapshot->curves.size();
+			snapshot->curves.push_back( layer->curve );
+		}
+		snapshot->curve_ids.push_back( curve_id );
+
+		result.layers.push_back( layer );
+		result.revisions.push_back( layer->revision );
+	}
+
+	_pending_count++;
+	_pending_packs.push_back( pack );
+	_pool.submit( 
+		[this, result, snapshot]() mutable 
+		{
+			//  Curves aren't moved anymore, point to them
+			for ( size_t i = 0; i < snapshot->items.size(); i++ )
+			{
+				const int curve_id = snapshot->curve_ids[i];
+				if ( curve_id < 0 ) continue;
+
+				snapshot->items[i].curve = &snapshot->curves[curve_id];
+			}
+
+			result.is_success = result.pack->save( snapshot->items );
+
+			std::lock_guard<std::mutex> lock( _mutex );
+			_pack_results.push_back( std::move( result ) );
+			_condition.notify_all();
+		} 
+	);
+}
+
+std::vector<CurveSaveResult> CurveSaver::pop_results()
+{
+	std::vector<CurveSaveResult> results;
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		results.swap( _results );
+	}
+
+	_pending_count -= (int)results.size();
+	return results;
+}
+
+std::vector<CurvePackSaveResult> CurveSaver::pop_pack_results()
+{
+	std::vector<CurvePackSaveResult> results;
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		results.swap( _pack_results );
+	}
+
+	//  Packs can be accessed again
+	for ( const CurvePackSaveResult& result : results )
+	{
+		_pending_packs.erase( std::find( 
+			_pending_packs.begin(), _pending_packs.end(), result.pack ) );
+	}
+
+	_pending_count -= (int)results.size();
+	return results;
+}
+
+void CurveSaver::wait()
+{
+	TRACE_SCOPE( "CurveSaver::wait" );
+
+	std::unique_lock<std::mutex> lock( _mutex );
+	_condition.wait( lock, [this]() 
+	{
+		return (int)( _results.size() + _pack_results.size() ) == _pending_count;
+	} );
+}
+
+bool CurveSaver::is_busy() const
+{
+	return _pending_count > 0;
+}
+
+bool CurveSaver::is_saving_pack( const ref<CurvePack>& pack ) const
+{
+	return std::find( _pending_packs.begin(), _pending_packs.end(), pack ) 
+		!= _pending_packs.end();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <src/curve-layer.h>
+#include <src/curve-pack.h>
+#include <src/usings.h>
+#include <src/worker-pool.h>
+
+namespace curve_editor_x
+{
+	struct CurveSaveResult
+	{
+		//  Weak to never release a layer, and its GPU resources,
+		//  from a worker thread
+		std::weak_ptr<CurveLayer> layer;
+		std::string path;
+		//  Layer's revision when its curve was snapshotted
+		int revision = 0;
+
+		bool is_success = false;
+	};
+
+	struct CurvePackSaveResult
+	{
+		ref<CurvePack> pack;
+		//  Layers in the order of the new table of contents, with
+		//  their revisions when snapshotted
+		std::vector<std::weak_ptr<CurveLayer>> layers;
+		std::vector<int> revisions;
+
+		bool is_success = false;
+	};
+
+	/*
+	 * Writes snapshots of curves into files or packs on a background
+	 * thread, one after the other so successive saves of a file land
+	 * in order. The results are collected by the main thread.
+	 */
+	class CurveSaver
+	{
+	public:
+		/*
+		 * Copies the layer's curve and queues its writing.
+		 */
+		void save( ref<CurveLayer> layer, const std::string& path );
+		/*
+		 * Copies the changed curves of the pack's layers and queues
+		 * the pack's save. Until its result is collected, the pack
+		 * belongs to the background thread and mustn't be accessed.
+		 */
+		void save_pack( 
+			ref<CurvePack> pack, 
+			const std::vector<ref<CurveLayer>>& layers 
+		);
+
+		/*
+		 * Moves out the results of the finished saves.
+		 */
+		std::vector<CurveSaveResult> pop_results();
+		std::vector<CurvePackSaveResult> pop_pack_results();
+
+		/*
+		 * Blocks until all queued saves are finished, their results
+		 * still having to be collected.
+		 */
+		void wait();
+
+		/*
+		 * Returns whether some saves haven't been collected yet.
+		 */
+		bool is_busy() const;
+		/*
+		 * Returns whether a save of the pack hasn't been collected 
+		 * yet.
+		 */
+		bool is_saving_pack( const ref<CurvePack>& pack ) const;
+
+	private:
+		//  Main thread only
+		int _pending_count = 0;
+		std::vector<ref<CurvePack>> _pending_packs {};
+
+		std::mutex _mutex {};
+		std::condition_variable _condition {};
+		std::vector<CurveSaveResult> _results {};
+		std::vector<CurvePackSaveResult> _pack_results {};
+
+		//  Last member to be destroyed first, finishing the queued
+		//  saves before the results are released
+		WorkerPool _pool { 1 };
+	};
+}
@@ -0,0 +1,308 @@
+#include "curve-segment-tree.h"
+
+#include <src/trace.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+void CurveSegmentTree::rebuild( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveSegmentTree::rebuild" );
+
+	const int segments_count = std::max( 0, curve.get_keys_count() - 1 );
+
+	_nodes.clear();
+	_segments.resize( segments_count );
+	_leaf_ids.resize( segments_count );
+
+	std::vector<int> segment_ids( segments_count );
+	for ( int i = 0; i < segments_count; i++ )
+	{
+		_segments[i] = CurveSegment::from_curve( curve, i );
+		segment_ids[i] = i;
+	}
+
+	//  A binary tree with N leaves has 2N-1 nodes
+	if ( segments_count > 0 )
+	{
+		_nodes.reserve( segments_count * 2 - 1 );
+		_build_node( segment_ids, 0, segments_count, -1 );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveSegmentTree::update( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveSegmentTree::update" );
+
+	const int segments_count = curve.get_keys_count() - 1;
+
+	//  Keys have been added or removed, segments are shifted
+	if ( _dirty_range.is_fully_dirty 
+	  || segments_count != (int)_segments.size() )
+	{
+		rebuild( curve );
+		return;
+	}
+	if ( !_dirty_range.is_dirty() ) return;
+
+	//  Refit segments on both sides of the edited keys
+	int first_segment_id, last_segment_id;
+	_dirty_range.get_segments_range( 
+		segments_count, &first_segment_id, &last_segment_id );
+	for ( int i = first_segment_id; i <= last_segment_id; i++ )
+	{
+		_refit_segment( curve, i );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveSegmentTree::invalidate()
+{
+	_dirty_range.invalidate();
+}
+
+void CurveSegmentTree::invalidate_key( int key_id )
+{
+	_dirty_range.invalidate_key( key_id );
+}
+
+bool CurveSegmentTree::is_dirty() const
+{
+	return _dirty_range.is_dirty();
+}
+
+bool CurveSegmentTree::find_nearest_point_to(
+	const Point& point,
+	CurveNearestPoint* result
+) const
+{
+	if ( _nodes.empty() ) return false;
+
+	struct Candidate
+	{
+		int node_id;
+		float distance_sqr;
+	};
+
+	CurveNearestPoint best {};
+	best.distance_sqr = INFINITY;
+
+	std::vector<Candidate> stack;
+	stack.push_back( { 0, _get_distance_sqr_to_extrems( point, _nodes[0].extrems ) } );
+	while ( !stack.empty() )
+	{
+		const Candidate candidate = stack.back();
+		stack.pop_back();
+
+		//  Prune boxes further than the best point found so far
+		if ( candidate.distance_sqr >= best.distance_sqr ) continue;
+
+		const Node& node = _nodes[candidate.node_id];
+
+		//  Leaf: refine on the exact segment
+		if ( node.segment_id >= 0 )
+		{
+			const CurveSegment& segment = _segments[node.segment_id];
+			const float t = segment.find_nearest_progress_to( point );
+			const Point pos = segment.evaluate( t );
+			const float dx = pos.x - point.x;
+			const float dy = pos.y - point.y;
+			const float distance_sqr = dx * dx + dy * dy;
+
+			if ( distance_sqr < best.distance_sqr )
+			{
+				best.segment_id = node.segment_id;
+				best.t = t;
+				best.point = pos;
+				best.distance_sqr = distance_sqr;
+			}
+			continue;
+		}
+
+		//  Push the furthest child first so the closest is visited first
+		Candidate left {
+			node.left_id,
+			_get_distance_sqr_to_extrems( point, _nodes[node.left_id].extrems )
+		};
+		Candidate right {
+			node.right_id,
+			_get_distance_sqr_to_extrems( point, _nodes[node.right_id].extrems )
+		};
+		if ( left.distance_sqr < right.distance_sqr )
+		{
+			std::swap( left, right );
+		}
+		stack.push_back( left );
+		stack.push_back( right );
+	}
+
+	*result = best;
+	return true;
+}
+
+void CurveSegmentTree::find_segments_in(
+	const CurveExtrems& extrems,
+	std::vector<int>* segment_ids
+) const
+{
+	segment_ids->clear();
+	if ( _nodes.empty() ) return;
+
+	std::vector<int> stack;
+	stack.push_back( 0 );
+	while ( !stack.empty() )
+	{
+		const Node& node = _nodes[stack.back()];
+		stack.pop_back();
+
+		//  Skip whole sub-trees outside of the bounds
+		if ( !_is_overlapping( node.extrems, extrems ) ) continue;
+
+		if ( node.segment_id >= 0 )
+		{
+			segment_ids->push_back( node.segment_id );
+			continue;
+		}
+
+		stack.push_back( node.left_id );
+		stack.push_back( node.right_id );
+	}
+
+	//  Leaves are spatially, not sequentially, ordered
+	std::sort( segment_ids->begin(), segment_ids->end() );
+}
+
+const CurveSegment& CurveSegmentTree::get_segment( int segment_id ) const
+{
+	return _segments[segment_id];
+}
+
+int CurveSegmentTree::get_segments_count() const
+{
+	return (int)_segments.size();
+}
+
+int CurveSegmentTree::_build_node(
+	std::vector<int>& segment_ids,
+	int first,
+	int last,
+	int parent_id
+)
+{
+	const int node_id = (int)_nodes.size();
+	_nodes.push_back( Node {} );
+	_nodes[node_id].parent_id = parent_id;
+
+	//  Leaf
+	if ( last - first == 1 )
+	{
+		const int segment_id = segment_ids[first];
+		_nodes[node_id].segment_id = segment_id;
+		_nodes[node_id].extrems = _segments[segment_id].get_hull_extrems();
+		_leaf_ids[segment_id] = node_id;
+		return node_id;
+	}
+
+	//  Compute bounds of all segments' centers
+	CurveExtrems centers {};
+	centers.min_x = centers.min_y = INFINITY;
+	centers.max_x = centers.max_y = -INFINITY;
+	for ( int i = first; i < last; i++ )
+	{
+		const CurveSegment& segment = _segments[segment_ids[i]];
+		const float x = ( segment.p0.x + segment.p3.x ) * 0.5f;
+		const float y = ( segment.p0.y + segment.p3.y ) * 0.5f;
+		centers.min_x = std::min( centers.min_x, x );
+		centers.max_x = std::max( centers.max_x, x );
+		centers.min_y = std::min( centers.min_y, y );
+		centers.max_y = std::max( centers.max_y, y );
+	}
+
+	//  Split at the median along the largest axis
+	const bool is_x_axis = centers.max_x - centers.min_x
+		>= centers.max_y - centers.min_y;
+	const int middle = ( first + last ) / 2;
+	std::nth_element(
+		segment_ids.begin() + first,
+		segment_ids.begin() + middle,
+		segment_ids.begin() + last,
+		[&]( int a, int b ) {
+			const CurveSegment& segment_a = _segments[a];
+			const CurveSegment& segment_b = _segments[b];
+			return is_x_axis
+				? segment_a.p0.x + segment_a.p3.x < segment_b.p0.x + segment_b.p3.x
+				: segment_a.p0.y + segment_a.p3.y < segment_b.p0.y + segment_b.p3.y;
+		}
+	);
+
+	//  Build children (the nodes vector may re-allocate meanwhile)
+	const int left_id = _build_node( segment_ids, first, middle, node_id );
+	const int right_id = _build_node( segment_ids, middle, last, node_id );
+
+	Node& node = _nodes[node_id];
+	node.left_id = left_id;
+	node.right_id = right_id;
+	node.extrems = _merge_extrems(
+		_nodes[left_id].extrems,
+		_nodes[right_id].extrems
+	);
+	return node_id;
+}
+
+void CurveSegmentTree::_refit_segment( const Curve& curve, int segment_id )
+{
+	_segments[segment_id] = CurveSegment::from_curve( curve, segment_id );
+
+	//  Update leaf bounds
+	int node_id = _leaf_ids[segment_id];
+	_nodes[node_id].extrems = _segments[segment_id].get_hull_extrems();
+
+	//  Propagate to ancestors
+	node_id = _nodes[node_id].parent_id;
+	while ( node_id >= 0 )
+	{
+		Node& node = _nodes[node_id];
+		node.extrems = _merge_extrems(
+			_nodes[node.left_id].extrems,
+			_nodes[node.right_id].extrems
+		);
+		node_id = node.parent_id;
+	}
+}
+
+CurveExtrems CurveSegmentTree::_merge_extrems(
+	const CurveExtrems& a,
+	const CurveExtrems& b
+)
+{
+	CurveExtrems extrems {};
+	extrems.min_x = std::min( a.min_x, b.min_x );
+	extrems.max_x = std::max( a.max_x, b.max_x );
+	extrems.min_y = std::min( a.min_y, b.min_y );
+	extrems.max_y = std::max( a.max_y, b.max_y );
+	return extrems;
+}
+
+bool CurveSegmentTree::_is_overlapping(
+	const CurveExtrems& a,
+	const CurveExtrems& b
+)
+{
+	return a.min_x <= b.max_x && a.max_x >= b.min_x
+		&& a.min_y <= b.max_y && a.max_y >= b.min_y;
+}
+
+float CurveSegmentTree::_get_distance_sqr_to_extrems(
+	const Point& point,
+	const CurveExtrems& extrems
+)
+{
+	const float dx = std::max( { extrems.min_x - point.x, 0.0f, point.x - extrems.max_x } );
+	const float dy = std::max( { extrems.min_y - point.y, 0.0f, point.y - extrems.max_y } );
+	return dx * dx + dy * dy;
+}
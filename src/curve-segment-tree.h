@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/curve-segment.h>
+#include <src/dirty-key-range.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Result of a nearest-point query on a curve.
+	 */
+	struct CurveNearestPoint
+	{
+		int segment_id = -1;
+		float t = 0.0f;
+		Point point {};
+		float distance_sqr = 0.0f;
+	};
+
+	/*
+	 * Bounding-box hierarchy over the segments of a curve, built from
+	 * the control hull of each pair of keys.
+	 *
+	 * Nearest-point queries descend the closest boxes first and prune
+	 * every box further than the best candidate, so that only a handful
+	 * of segments are refined regardless of the keys count.
+	 */
+	class CurveSegmentTree
+	{
+	public:
+		/*
+		 * Rebuilds the whole hierarchy from the curve's segments.
+		 */
+		void rebuild( const Curve& curve );
+		/*
+		 * Refits the boxes of the segments invalidated since the last
+		 * update, or rebuilds the whole hierarchy if it was entirely
+		 * invalidated.
+		 */
+		void update( const Curve& curve );
+
+		/*
+		 * Invalidates the whole hierarchy.
+		 */
+		void invalidate();
+		/*
+		 * Invalidates the (at most two) segments around a key.
+		 */
+		void invalidate_key( int key_id );
+		bool is_dirty() const;
+
+		/*
+		 * Finds the closest point on the curve to the given point.
+		 * Returns false if the curve has no segments.
+		 */
+		bool find_nearest_point_to(
+			const Point& point,
+			CurveNearestPoint* result
+		) const;
+
+		/*
+		 * Collects the segments whose control hull overlaps the given
+		 * bounds, sorted by ascending ids.
+		 */
+		void find_segments_in(
+			const CurveExtrems& extrems,
+			std::vector<int>* segment_ids
+		) const;
+
+		const CurveSegment& get_segment( int segment_id ) const;
+		int get_segments_count() const;
+
+	private:
+		struct Node
+		{
+			CurveExtrems extrems {};
+
+			int parent_id = -1;
+			//  Children nodes, both -1 for leaves
+			int left_id = -1;
+			int right_id = -1;
+			//  Segment of a leaf, -1 for inner nodes
+			int segment_id = -1;
+		};
+
+		int _build_node(
+			std::vector<int>& segment_ids,
+			int first,
+			int last,
+			int parent_id
+		);
+		void _refit_segment( const Curve& curve, int segment_id );
+
+		static CurveExtrems _merge_extrems(
+			const CurveExtrems& a,
+			const CurveExtrems& b
+		);
+		static bool _is_overlapping(
+			const CurveExtrems& a,
+			const CurveExtrems& b
+		);
+		static float _get_distance_sqr_to_extrems(
+			const Point& point,
+			const CurveExtrems& extrems
+		);
+
+	private:
+		std::vector<Node> _nodes {};
+		std::vector<CurveSegment> _segments {};
+		//  Leaf node of each segment
+		std::vector<int> _leaf_ids {};
+
+		DirtyKeyRange _dirty_range {};
+	};
+}
@@ -0,0 +1,210 @@
+#include "curve-segment.h"
+
+#include <src/settings.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+CurveSegment::CurveSegment(
+	const CurveKey& current_key,
+	const CurveKey& next_key
+)
+{
+	//  Tangents are stored relative to their control point
+	p0 = current_key.control;
+	p1 = Point {
+		current_key.control.x + current_key.right_tangent.x,
+		current_key.control.y + current_key.right_tangent.y,
+	};
+	p2 = Point {
+		next_key.control.x + next_key.left_tangent.x,
+		next_key.control.y + next_key.left_tangent.y,
+	};
+	p3 = next_key.control;
+}
+
+CurveSegment CurveSegment::from_curve(
+	const Curve& curve,
+	int segment_id
+)
+{
+	return CurveSegment(
+		curve.get_key( segment_id ),
+		curve.get_key( segment_id + 1 )
+	);
+}
+
+Point CurveSegment::evaluate( float t ) const
+{
+	const float u = 1.0f - t;
+	const float w0 = u * u * u;
+	const float w1 = 3.0f * u * u * t;
+	const float w2 = 3.0f * u * t * t;
+	const float w3 = t * t * t;
+
+	return Point {
+		w0 * p0.x + w1 * p1.x + w2 * p2.x + w3 * p3.x,
+		w0 * p0.y + w1 * p1.y + w2 * p2.y + w3 * p3.y,
+	};
+}
+
+Point CurveSegment::derivative( float t ) const
+{
+	const float u = 1.0f - t;
+	const float w0 = 3.0f * u * u;
+	const float w1 = 6.0f * u * t;
+	const float w2 = 3.0f * t * t;
+
+	return Point {
+		w0 * ( p1.x - p0.x ) + w1 * ( p2.x - p1.x ) + w2 * ( p3.x - p2.x ),
+		w0 * ( p1.y - p0.y ) + w1 * ( p2.y - p1.y ) + w2 * ( p3.y - p2.y ),
+	};
+}
+
+Point CurveSegment::second_derivative( float t ) const
+{
+	const float u = 1.0f - t;
+
+	return Point {
+		6.0f * ( u * ( p2.x - 2.0f * p1.x + p0.x ) + t * ( p3.x - 2.0f * p2.x + p1.x ) ),
+		6.0f * ( u * ( p2.y - 2.0f * p1.y + p0.y ) + t * ( p3.y - 2.0f * p2.y + p1.y ) ),
+	};
+}
+
+float CurveSegment::get_length( float t0, float t1 ) const
+{
+	//  5-points Gauss-Legendre abscissas & weights on [-1; 1]
+	constexpr int POINTS_COUNT = 5;
+	constexpr float ABSCISSAS[POINTS_COUNT] {
+		0.0f, 
+		-0.5384693101f, 0.5384693101f, 
+		-0.9061798459f, 0.9061798459f,
+	};
+	constexpr float WEIGHTS[POINTS_COUNT] {
+		0.5688888889f, 
+		0.4786286705f, 0.4786286705f, 
+		0.2369268851f, 0.2369268851f,
+	};
+
+	const float half_range = ( t1 - t0 ) * 0.5f;
+	const float center = ( t1 + t0 ) * 0.5f;
+
+	float length = 0.0f;
+	for ( int i = 0; i < POINTS_COUNT; i++ )
+	{
+		const Point speed = derivative( center + half_range * ABSCISSAS[i] );
+		length += WEIGHTS[i] * sqrtf( speed.x * speed.x + speed.y * speed.y );
+	}
+
+	return length * half_range;
+}
+
+void CurveSegment::split( 
+	float t, 
+	CurveSegment* left, 
+	CurveSegment* right 
+) const
+{
+	const float u = 1.0f - t;
+
+	//  First level of interpolation
+	const Point p01 { p0.x * u + p1.x * t, p0.y * u + p1.y * t };
+	const Point p12 { p1.x * u + p2.x * t, p1.y * u + p2.y * t };
+	const Point p23 { p2.x * u + p3.x * t, p2.y * u + p3.y * t };
+
+	//  Second level
+	const Point p012 { p01.x * u + p12.x * t, p01.y * u + p12.y * t };
+	const Point p123 { p12.x * u + p23.x * t, p12.y * u + p23.y * t };
+
+	//  Point on the segment
+	const Point p0123 { p012.x * u + p123.x * t, p012.y * u + p123.y * t };
+
+	left->p0 = p0;
+	left->p1 = p01;
+	left->p2 = p012;
+	left->p3 = p0123;
+
+	right->p0 = p0123;
+	right->p1 = p123;
+	right->p2 = p23;
+	right->p3 = p3;
+}
+
+bool CurveSegment::is_flat( const Point& scale, float tolerance ) const
+{
+	//  Bounds the distance between the segment and its chord by the
+	//  deviation of the inner control points
+	float ux = ( 3.0f * p1.x - 2.0f * p0.x - p3.x ) * scale.x;
+	float uy = ( 3.0f * p1.y - 2.0f * p0.y - p3.y ) * scale.y;
+	float vx = ( 3.0f * p2.x - 2.0f * p3.x - p0.x ) * scale.x;
+	float vy = ( 3.0f * p2.y - 2.0f * p3.y - p0.y ) * scale.y;
+	ux *= ux;
+	uy *= uy;
+	vx *= vx;
+	vy *= vy;
+
+	return std::max( ux, vx ) + std::max( uy, vy ) 
+		<= 16.0f * tolerance * tolerance;
+}
+
+CurveExtrems CurveSegment::get_hull_extrems() const
+{
+	CurveExtrems extrems {};
+	extrems.min_x = std::min( { p0.x, p1.x, p2.x, p3.x } );
+	extrems.max_x = std::max( { p0.x, p1.x, p2.x, p3.x } );
+	extrems.min_y = std::min( { p0.y, p1.y, p2.y, p3.y } );
+	extrems.max_y = std::max( { p0.y, p1.y, p2.y, p3.y } );
+	return extrems;
+}
+
+float CurveSegment::find_nearest_progress_to( const Point& point ) const
+{
+	constexpr int SAMPLES_COUNT = settings::NEAREST_SEGMENT_SAMPLES;
+	constexpr int ITERATIONS_COUNT = settings::NEAREST_NEWTON_ITERATIONS;
+
+	//  Coarse search on uniform samples
+	float best_t = 0.0f;
+	float best_distance_sqr = INFINITY;
+	for ( int i = 0; i <= SAMPLES_COUNT; i++ )
+	{
+		const float t = (float)i / (float)SAMPLES_COUNT;
+		const Point pos = evaluate( t );
+		const float dx = pos.x - point.x;
+		const float dy = pos.y - point.y;
+		const float distance_sqr = dx * dx + dy * dy;
+
+		if ( distance_sqr < best_distance_sqr )
+		{
+			best_t = t;
+			best_distance_sqr = distance_sqr;
+		}
+	}
+
+	//  Refine with Newton iterations on 'dot(pos(t) - point, pos'(t))'
+	float t = best_t;
+	for ( int i = 0; i < ITERATIONS_COUNT; i++ )
+	{
+		const Point pos = evaluate( t );
+		const Point d1 = derivative( t );
+		const Point d2 = second_derivative( t );
+		const float dx = pos.x - point.x;
+		const float dy = pos.y - point.y;
+
+		const float numerator = dx * d1.x + dy * d1.y;
+		const float denominator = d1.x * d1.x + d1.y * d1.y 
+			+ dx * d2.x + dy * d2.y;
+		if ( denominator == 0.0f ) break;
+
+		t = std::clamp( t - numerator / denominator, 0.0f, 1.0f );
+	}
+
+	//  Keep the refined progress only if it is actually closer
+	const Point pos = evaluate( t );
+	const float dx = pos.x - point.x;
+	const float dy = pos.y - point.y;
+	if ( dx * dx + dy * dy > best_distance_sqr ) return best_t;
+
+	return t;
+}
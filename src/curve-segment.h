@@ -0,0 +1,77 @@
+#pragma once
+
+#include <curve-x/curve.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Cubic Bézier segment between two consecutive curve keys,
+	 * with its four control points expressed in curve-space.
+	 */
+	struct CurveSegment
+	{
+	public:
+		CurveSegment() {}
+		CurveSegment(
+			const CurveKey& current_key,
+			const CurveKey& next_key
+		);
+
+		/*
+		 * Returns the segment between keys 'segment_id' and
+		 * 'segment_id + 1' of the curve.
+		 */
+		static CurveSegment from_curve(
+			const Curve& curve,
+			int segment_id
+		);
+
+		/*
+		 * Evaluates the position at progress 't' (from 0.0 to 1.0).
+		 */
+		Point evaluate( float t ) const;
+		/*
+		 * Evaluates the first derivative at progress 't'.
+		 */
+		Point derivative( float t ) const;
+		/*
+		 * Evaluates the second derivative at progress 't'.
+		 */
+		Point second_derivative( float t ) const;
+		/*
+		 * Returns the length of the segment between progresses
+		 * 't0' and 't1' using a Gauss-Legendre quadrature.
+		 */
+		float get_length( float t0 = 0.0f, float t1 = 1.0f ) const;
+
+		/*
+		 * Splits the segment at progress 't' into two segments covering
+		 * [0; t] and [t; 1] using de Casteljau's algorithm.
+		 */
+		void split( float t, CurveSegment* left, CurveSegment* right ) const;
+		/*
+		 * Returns whether the segment deviates from its chord by less 
+		 * than the tolerance, once scaled on each axis.
+		 */
+		bool is_flat( const Point& scale, float tolerance ) const;
+
+		/*
+		 * Returns the bounds of the control points, which always
+		 * contain the whole segment.
+		 */
+		CurveExtrems get_hull_extrems() const;
+		/*
+		 * Finds the progress of the closest point on the segment to
+		 * the given point.
+		 */
+		float find_nearest_progress_to( const Point& point ) const;
+
+	public:
+		Point p0 {};
+		Point p1 {};
+		Point p2 {};
+		Point p3 {};
+	};
+}
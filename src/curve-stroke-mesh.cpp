@@ -0,0 +1,140 @@
+#include "curve-stroke-mesh.h"
+
+#include <raymath.h>
+#include <rlgl.h>
+
+#include <src/curve-tessellation.h>
+#include <src/profiler.h>
+#include <src/settings.h>
+
+using namespace curve_editor_x;
+
+CurveStrokeMesh::~CurveStrokeMesh()
+{
+	unload();
+}
+
+bool CurveStrokeMesh::is_dirty(
+	int revision,
+	CurveInterpolateMode mode,
+	const Point& scale,
+	float thickness
+) const
+{
+	const Point mesh_scale = get_mesh_scale( scale );
+	return _revision != revision || _mode != mode
+		|| _mesh_scale.x != mesh_scale.x || _mesh_scale.y != mesh_scale.y
+		|| _thickness != thickness;
+}
+
+Point CurveStrokeMesh::get_mesh_scale( const Point& scale )
+{
+	return Point {
+		_get_mesh_scale( scale.x ),
+		_get_mesh_scale( scale.y ),
+	};
+}
+
+void CurveStrokeMesh::upload(
+	const std::vector<Vector2>& vertices,
+	int revision,
+	CurveInterpolateMode mode,
+	const Point& scale,
+	float thickness
+)
+{
+	_unload_mesh();
+
+	_revision = revision;
+	_mode = mode;
+	_mesh_scale = get_mesh_scale( scale );
+	_thickness = thickness;
+
+	if ( vertices.empty() ) return;
+
+	//  Copy vertices, raylib takes ownership of the buffer
+	const int vertices_count = (int)vertices.size();
+	_mesh.vertexCount = vertices_count;
+	_mesh.triangleCount = vertices_count / 3;
+	_mesh.vertices = (float*)MemAlloc(
+		(unsigned int)( vertices_count * 3 * sizeof( float ) ) );
+	for ( int i = 0; i < vertices_count; i++ )
+	{
+		_mesh.vertices[i * 3 + 0] = vertices[i].x;
+		_mesh.vertices[i * 3 + 1] = vertices[i].y;
+		_mesh.vertices[i * 3 + 2] = 0.0f;
+	}
+
+	UploadMesh( &_mesh, false );
+	_is_uploaded = true;
+}
+
+void CurveStrokeMesh::unload()
+{
+	_unload_mesh();
+
+	if ( _has_material )
+	{
+		UnloadMaterial( _material );
+		_material = Material {};
+		_has_material = false;
+	}
+
+	_revision = -1;
+}
+
+void CurveStrokeMesh::render( 
+	const Vector2& origin, 
+	const Point& scale, 
+	const Color& color 
+)
+{
+	if ( !_is_uploaded ) return;
+
+	ProfilerScope scope( "Draw submission" );
+
+	if ( !_has_material )
+	{
+		_material = LoadMaterialDefault();
+		_has_material = true;
+	}
+	_material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+
+	//  Draw pending batched shapes first to keep the drawing order
+	rlDrawRenderBatchActive();
+
+	//  The mesh is flat, don't bother about its winding
+	rlDisableBackfaceCulling();
+	const Matrix transform = MatrixMultiply(
+		MatrixScale( 
+			scale.x / _mesh_scale.x, 
+			scale.y / _mesh_scale.y, 
+			1.0f 
+		),
+		MatrixTranslate( origin.x, origin.y, 0.0f )
+	);
+	DrawMesh( _mesh, _material, transform );
+	rlEnableBackfaceCulling();
+	Profiler::add_count( "Draw submissions", 1 );
+}
+
+void CurveStrokeMesh::_unload_mesh()
+{
+	if ( !_is_uploaded ) return;
+
+	UnloadMesh( _mesh );
+	_mesh = Mesh {};
+	_is_uploaded = false;
+}
+
+float CurveStrokeMesh::_get_mesh_scale( float scale )
+{
+	//  Buckets are clamped, the exact scale is used past them so the
+	//  mesh is never scaled further than a bucket
+	if ( !( scale >= settings::CURVE_TESSELLATION_MIN_SCALE 
+	     && scale <= settings::CURVE_TESSELLATION_MAX_SCALE ) ) 
+		return scale;
+
+	return CurveTessellation::get_bucket_scale( 
+		CurveTessellation::get_scale_bucket( scale ) );
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+#include <curve-x/curve.h>
+
+#include <src/curve-interpolate-mode.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * GPU mesh of a stroked curve, kept across frames.
+	 *
+	 * Vertices are in screen-space relative to the curve's origin, so
+	 * that panning only changes the translation it is drawn with. They
+	 * are projected with the scale of the tessellation's zoom bucket,
+	 * the mesh being scaled to the exact zoom when drawn: it's only
+	 * re-uploaded when the curve, its interpolation mode, the zoom
+	 * bucket or the stroke's thickness changes. Within a bucket, the
+	 * stroke then gets thinner by at most the bucket's ratio.
+	 *
+	 * Requires the window to be opened while uploading or unloading.
+	 */
+	class CurveStrokeMesh
+	{
+	public:
+		CurveStrokeMesh() {}
+		CurveStrokeMesh( const CurveStrokeMesh& ) = delete;
+		CurveStrokeMesh& operator=( const CurveStrokeMesh& ) = delete;
+		~CurveStrokeMesh();
+
+		bool is_dirty(
+			int revision,
+			CurveInterpolateMode mode,
+			const Point& scale,
+			float thickness
+		) const;
+
+		/*
+		 * Returns the screen scale to project the vertices with, for
+		 * the given screen scale.
+		 */
+		static Point get_mesh_scale( const Point& scale );
+
+		/*
+		 * Uploads the triangles (three vertices each), projected 
+		 * with the mesh scale, to the GPU, replacing the previous 
+		 * ones.
+		 */
+		void upload(
+			const std::vector<Vector2>& vertices,
+			int revision,
+			CurveInterpolateMode mode,
+			const Point& scale,
+			float thickness
+		);
+		/*
+		 * Releases the GPU resources, the mesh is then dirty.
+		 */
+		void unload();
+
+		/*
+		 * Draws the mesh scaled to the screen scale and translated to
+		 * the curve's origin on screen.
+		 */
+		void render( 
+			const Vector2& origin, 
+			const Point& scale, 
+			const Color& color 
+		);
+
+	private:
+		void _unload_mesh();
+
+		static float _get_mesh_scale( float scale );
+
+	private:
+		Mesh _mesh {};
+		Material _material {};
+		bool _is_uploaded = false;
+		bool _has_material = false;
+
+		int _revision = -1;
+		CurveInterpolateMode _mode = CurveInterpolateMode::MAX;
+		Point _mesh_scale {};
+		float _thickness = 0.0f;
+	};
+}
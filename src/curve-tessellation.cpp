@@ -0,0 +1,140 @@
+#include "curve-tessellation.h"
+
+#include <src/settings.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+void CurveTessellation::invalidate()
+{
+	_dirty_range.invalidate();
+}
+
+void CurveTessellation::invalidate_key( int key_id )
+{
+	_dirty_range.invalidate_key( key_id );
+}
+
+bool CurveTessellation::is_dirty( const Point& scale ) const
+{
+	return _dirty_range.is_dirty()
+		|| _scale_bucket_x != get_scale_bucket( scale.x )
+		|| _scale_bucket_y != get_scale_bucket( scale.y );
+}
+
+void CurveTessellation::update( const Curve& curve, const Point& scale )
+{
+	const int segments_count = curve.is_valid() ? curve.get_keys_count() - 1 : 0;
+
+	//  Tessellate for the upper scale of the buckets, so the tolerance
+	//  holds for any zoom inside them
+	const int scale_bucket_x = get_scale_bucket( scale.x );
+	const int scale_bucket_y = get_scale_bucket( scale.y );
+	const bool has_scale_changed = scale_bucket_x != _scale_bucket_x
+		|| scale_bucket_y != _scale_bucket_y;
+	_scale_bucket_x = scale_bucket_x;
+	_scale_bucket_y = scale_bucket_y;
+	_scale.x = get_bucket_scale( scale_bucket_x );
+	_scale.y = get_bucket_scale( scale_bucket_y );
+
+	//  Keys have been added or removed, segments are shifted
+	if ( _dirty_range.is_fully_dirty || has_scale_changed
+	  || segments_count != get_segments_count() )
+	{
+		_segments.resize( segments_count );
+		for ( Segment& segment : _segments )
+		{
+			segment.is_dirty = true;
+		}
+	}
+	else if ( _dirty_range.is_dirty() )
+	{
+		int first_segment_id, last_segment_id;
+		_dirty_range.get_segments_range( 
+			segments_count, &first_segment_id, &last_segment_id );
+		for ( int i = first_segment_id; i <= last_segment_id; i++ )
+		{
+			_segments[i].is_dirty = true;
+		}
+	}
+	_dirty_range.clear();
+}
+
+int CurveTessellation::get_segments_count() const
+{
+	return (int)_segments.size();
+}
+
+const std::vector<Point>& CurveTessellation::get_segment_points( 
+	const Curve& curve, 
+	int segment_id 
+)
+{
+	if ( _segments[segment_id].is_dirty )
+	{
+		_tessellate_segment( curve, segment_id );
+	}
+
+	return _segments[segment_id].points;
+}
+
+int CurveTessellation::pop_tessellated_points_count()
+{
+	const int count = _tessellated_points_count;
+	_tessellated_points_count = 0;
+	return count;
+}
+
+void CurveTessellation::_tessellate_segment( const Curve& curve, int segment_id )
+{
+	const CurveSegment segment = CurveSegment::from_curve( curve, segment_id );
+
+	Segment& cached_segment = _segments[segment_id];
+	cached_segment.points.clear();
+	cached_segment.points.push_back( segment.p0 );
+	_subdivide( segment, 0, &cached_segment.points );
+	cached_segment.is_dirty = false;
+
+	_tessellated_points_count += (int)cached_segment.points.size();
+}
+
+void CurveTessellation::_subdivide(
+	const CurveSegment& segment,
+	int depth,
+	std::vector<Point>* points
+) const
+{
+	if ( depth >= settings::CURVE_TESSELLATION_MAX_DEPTH
+	  || segment.is_flat( _scale, settings::CURVE_FLATNESS_TOLERANCE ) )
+	{
+		points->push_back( segment.p3 );
+		return;
+	}
+
+	//  Split in halves, left first to keep points ordered
+	CurveSegment left, right;
+	segment.split( 0.5f, &left, &right );
+	_subdivide( left, depth + 1, points );
+	_subdivide( right, depth + 1, points );
+}
+
+int CurveTessellation::get_scale_bucket( float scale )
+{
+	constexpr int ZOOM_BUCKETS = settings::CURVE_TESSELLATION_ZOOM_BUCKETS;
+	if ( !( scale > 0.0f ) || !std::isfinite( scale ) ) return 0;
+
+	//  Bound the subdivision of segments zoomed far in, and the
+	//  buckets of segments zoomed far out, which are already flat
+	scale = std::clamp( scale, 
+		settings::CURVE_TESSELLATION_MIN_SCALE, 
+		settings::CURVE_TESSELLATION_MAX_SCALE );
+	return (int)ceilf( log2f( scale ) * ZOOM_BUCKETS );
+}
+
+float CurveTessellation::get_bucket_scale( int bucket )
+{
+	return exp2f(
+		(float)bucket / (float)settings::CURVE_TESSELLATION_ZOOM_BUCKETS );
+}
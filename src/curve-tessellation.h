@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/curve-segment.h>
+#include <src/dirty-key-range.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Curve-space polyline of a curve, kept across frames.
+	 *
+	 * Segments are subdivided until they are flat within a tolerance
+	 * in screen pixels, so straight segments only keep their ends and
+	 * curvy ones get as many points as needed to not look faceted.
+	 * Distance-evaluation only re-parametrizes the same shape, while
+	 * time-evaluation is sampled by CurveTimeSamples instead.
+	 *
+	 * Each segment keeps its own polyline, tessellated on demand, so
+	 * only segments the view needs are ever tessellated. It's then
+	 * only re-tessellated once its keys have been edited or the zoom
+	 * left the bucket it was tessellated for. The screen scale is
+	 * quantized in zoom buckets and clamped, so zooming far in doesn't
+	 * subdivide without bound.
+	 */
+	class CurveTessellation
+	{
+	public:
+		/*
+		 * Invalidates all segments.
+		 */
+		void invalidate();
+		/*
+		 * Invalidates the (at most two) segments around a key.
+		 */
+		void invalidate_key( int key_id );
+
+		/*
+		 * Returns whether segments are out-of-date for the given
+		 * screen scale (pixels per curve unit on each axis).
+		 */
+		bool is_dirty( const Point& scale ) const;
+		/*
+		 * Marks out-of-date the segments invalidated since the last 
+		 * update, or all of them if the zoom left its bucket, to be
+		 * re-tessellated once requested.
+		 */
+		void update( const Curve& curve, const Point& scale );
+
+		int get_segments_count() const;
+		/*
+		 * Returns the polyline of a segment, from its first to its 
+		 * last control points included, tessellating it if 
+		 * out-of-date.
+		 */
+		const std::vector<Point>& get_segment_points( 
+			const Curve& curve, 
+			int segment_id 
+		);
+		/*
+		 * Returns the number of points tessellated since the last
+		 * call, for profiling.
+		 */
+		int pop_tessellated_points_count();
+
+		/*
+		 * Returns the zoom bucket of a screen scale, clamped, and
+		 * the upper scale a bucket stands for.
+		 */
+		static int get_scale_bucket( float scale );
+		static float get_bucket_scale( int bucket );
+
+	private:
+		struct Segment
+		{
+			std::vector<Point> points {};
+			bool is_dirty = true;
+		};
+
+		void _tessellate_segment( const Curve& curve, int segment_id );
+		void _subdivide(
+			const CurveSegment& segment,
+			int depth,
+			std::vector<Point>* points
+		) const;
+
+	private:
+		std::vector<Segment> _segments {};
+		int _tessellated_points_count = 0;
+
+		//  Zoom buckets on each axis and the scale they stand for
+		int _scale_bucket_x = 0;
+		int _scale_bucket_y = 0;
+		Point _scale {};
+
+		DirtyKeyRange _dirty_range {};
+	};
+}
@@ -0,0 +1,344 @@
+#include "curve-text-parser.h"
+
+#include <src/trace.h>
+
+#include <curve-x/curve-serializer.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+using namespace curve_editor_x;
+
+static bool is_blank( char c )
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool is_separator( char c )
+{
+	return c == ',' || c == ';';
+}
+
+static void skip_blanks( std::string_view line, size_t* offset )
+{
+	while ( *offset < line.size() && is_blank( line[*offset] ) )
+	{
+		( *offset )++;
+	}
+}
+
+static bool is_same_point( const Point& a, const Point& b )
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+static bool is_same_curve( const Curve& a, const Curve& b )
+{
+	if ( a.get_keys_count() != b.get_keys_count() ) return false;
+
+	for ( int i = 0; i < a.get_keys_count(); i++ )
+	{
+		const CurveKey& key_a = a.get_key( i );
+		const CurveKey& key_b = b.get_key( i );
+		if ( !is_same_point( key_a.control, key_b.control )
+		  || !is_same_point( key_a.left_tangent, key_b.left_tangent )
+		  || !is_same_point( key_a.right_tangent, key_b.right_tangent )
+		  || a.get_tangent_mode( i ) != b.get_tangent_mode( i ) )
+			return false;
+	}
+
+	return true;
+}
+
+bool CurveTextParser::parse( std::string_view data, Curve* curve )
+{
+	TRACE_SCOPE( "CurveTextParser::parse" );
+
+	begin();
+	feed( data );
+	return end( curve );
+}
+
+bool CurveTextParser::parse_from_file_descriptor( int file, Curve* curve )
+{
+	TRACE_SCOPE( "CurveTextParser::parse_from_file_descriptor" );
+
+	std::vector<char> buffer( READ_CHUNK_SIZE );
+
+	begin();
+	while ( true )
+	{
+#ifdef _WIN32
+		const int size = _read( file, buffer.data(), (unsigned int)buffer.size() );
+#else
+		const ssize_t size = read( file, buffer.data(), buffer.size() );
+#endif
+		if ( size < 0 )
+		{
+			_fail( 0, "Failed to read the file" );
+			return false;
+		}
+		if ( size == 0 ) break;
+
+		if ( !feed( std::string_view( buffer.data(), (size_t)size ) ) )
+			return false;
+	}
+
+	return end( curve );
+}
+
+void CurveTextParser::begin()
+{
+	_curve = Curve {};
+	_pending_line.clear();
+	_line = 0;
+	_has_version = false;
+	_has_failed = false;
+	_error = CurveTextError {};
+}
+
+bool CurveTextParser::feed( std::string_view chunk )
+{
+	if ( _has_failed ) return false;
+
+	while ( !chunk.empty() )
+	{
+		const char* line_end = (const char*)memchr(
+			chunk.data(), '\n', chunk.size() );
+
+		//  Carry the unfinished line over to the next chunk
+		if ( line_end == nullptr )
+		{
+			_pending_line.append( chunk.data(), chunk.size() );
+			break;
+		}
+
+		const size_t line_size = (size_t)( line_end - chunk.data() );
+		if ( _pending_line.empty() )
+		{
+			if ( !_parse_line( chunk.substr( 0, line_size ) ) ) return false;
+		}
+		else
+		{
+			_pending_line.append( chunk.data(), line_size );
+			if ( !_parse_line( _pending_line ) ) return false;
+			_pending_line.clear();
+		}
+
+		chunk.remove_prefix( line_size + 1 );
+	}
+
+	return true;
+}
+
+bool CurveTextParser::end( Curve* curve )
+{
+	if ( _has_failed ) return false;
+
+	//  Last line, without line break
+	if ( !_pending_line.empty() )
+	{
+		if ( !_parse_line( _pending_line ) ) return false;
+		_pending_line.clear();
+	}
+
+	if ( !_has_version )
+	{
+		_line++;
+		return _fail( 0, "Expected 'version:<integer>', got the end of the file" );
+	}
+
+	*curve = std::move( _curve );
+	_curve = Curve {};
+	return true;
+}
+
+const CurveTextError& CurveTextParser::get_error() const
+{
+	return _error;
+}
+
+bool CurveTextParser::is_serializer_compatible()
+{
+	static const bool is_compatible = []()
+	{
+		//  Awkward values & every tangent mode
+		Curve curve {};
+		curve.add_key( CurveKey(
+			Point { -1.5f, 0.1f }, Point { -0.25f, 0.0f }, Point { 0.3f, -1e-3f },
+			TangentMode::Mirrored ) );
+		curve.add_key( CurveKey(
+			Point { 0.7f, 12.345f }, Point { -0.2f, 0.5f }, Point { 0.4f, 0.25f },
+			TangentMode::Aligned ) );
+		curve.add_key( CurveKey(
+			Point { 3.0f, -2.0f / 3.0f }, Point { -1.0f, 2.0f }, Point { 0.5f, -7.0f },
+			TangentMode::Broken ) );
+
+		CurveSerializer serializer;
+		const std::string data = serializer.serialize( curve );
+
+		Curve parsed_curve {};
+		CurveTextParser parser;
+		return parser.parse( data, &parsed_curve )
+			&& is_same_curve( parsed_curve, serializer.unserialize( data ) );
+	}();
+
+	return is_compatible;
+}
+
+bool CurveTextParser::_parse_line( std::string_view line )
+{
+	_line++;
+
+	size_t offset = 0;
+	skip_blanks( line, &offset );
+
+	//  Blank line or comment
+	if ( offset == line.size() || line[offset] == '#' ) return true;
+
+	if ( !_has_version ) return _parse_version( line );
+	return _parse_key( line );
+}
+
+bool CurveTextParser::_parse_version( std::string_view line )
+{
+	size_t offset = 0;
+	skip_blanks( line, &offset );
+
+	constexpr std::string_view NAME = "version";
+	if ( line.substr( offset, NAME.size() ) != NAME )
+		return _fail( offset, "Expected 'version:<integer>'" );
+	offset += NAME.size();
+
+	skip_blanks( line, &offset );
+	if ( offset == line.size() || ( line[offset] != ':' && line[offset] != '=' ) )
+		return _fail( offset, "Expected ':' after 'version'" );
+	offset++;
+	skip_blanks( line, &offset );
+
+	int version = 0;
+	const char* end = line.data() + line.size();
+	const auto result = std::from_chars( line.data() + offset, end, version );
+	if ( result.ec != std::errc() )
+		return _fail( offset, "Expected an integer version" );
+	if ( version != VERSION )
+		return _fail( offset, "Unsupported version" );
+	offset = (size_t)( result.ptr - line.data() );
+
+	skip_blanks( line, &offset );
+	if ( offset != line.size() )
+		return _fail( offset, "Unexpected character after the version" );
+
+	_has_version = true;
+	return true;
+}
+
+bool CurveTextParser::_parse_key( std::string_view line )
+{
+	//  Skip the key's label
+	size_t offset = 0;
+	const size_t label_end = line.find( ':' );
+	if ( label_end != std::string_view::npos )
+	{
+		offset = label_end + 1;
+	}
+
+	//  Control, left tangent & right tangent
+	float values[6];
+	for ( int i = 0; i < 6; i++ )
+	{
+		if ( !_parse_float( line, &offset, &values[i] ) ) return false;
+
+		skip_blanks( line, &offset );
+		if ( offset == line.size() || !is_separator( line[offset] ) )
+			return _fail( offset, "Expected ',' or ';' after a key's number" );
+		offset++;
+	}
+
+	int tangent_mode = 0;
+	if ( !_parse_tangent_mode( line, &offset, &tangent_mode ) ) return false;
+
+	skip_blanks( line, &offset );
+	if ( offset != line.size() )
+		return _fail( offset, "Unexpected character after the key" );
+
+	_curve.add_key( CurveKey(
+		Point { values[0], values[1] },
+		Point { values[2], values[3] },
+		Point { values[4], values[5] },
+		(TangentMode)tangent_mode
+	) );
+	return true;
+}
+
+bool CurveTextParser::_parse_float(
+	std::string_view line,
+	size_t* offset,
+	float* value
+)
+{
+	skip_blanks( line, offset );
+
+	const char* end = line.data() + line.size();
+	const auto result = std::from_chars( line.data() + *offset, end, *value );
+	if ( result.ec != std::errc() || !std::isfinite( *value ) )
+		return _fail( *offset, "Expected a finite number" );
+
+	*offset = (size_t)( result.ptr - line.data() );
+	return true;
+}
+
+bool CurveTextParser::_parse_tangent_mode(
+	std::string_view line,
+	size_t* offset,
+	int* value
+)
+{
+	constexpr std::string_view NAMES[] { "Mirrored", "Aligned", "Broken" };
+	static_assert( std::size( NAMES ) == (size_t)TangentMode::MAX );
+
+	skip_blanks( line, offset );
+
+	//  Integer
+	const char* end = line.data() + line.size();
+	const auto result = std::from_chars( line.data() + *offset, end, *value );
+	if ( result.ec == std::errc() )
+	{
+		if ( *value < 0 || *value >= (int)TangentMode::MAX )
+			return _fail( *offset, "Invalid tangent mode" );
+
+		*offset = (size_t)( result.ptr - line.data() );
+		return true;
+	}
+
+	//  Name
+	for ( int i = 0; i < (int)TangentMode::MAX; i++ )
+	{
+		if ( line.substr( *offset, NAMES[i].size() ) != NAMES[i] ) continue;
+
+		*value = i;
+		*offset += NAMES[i].size();
+		return true;
+	}
+
+	return _fail( *offset, "Expected a tangent mode" );
+}
+
+bool CurveTextParser::_fail( size_t offset, const char* message )
+{
+	_has_failed = true;
+
+	_error.line = _line;
+	_error.column = (int)offset + 1;
+	_error.message = message;
+	return false;
+}
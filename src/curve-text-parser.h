@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <curve-x/curve.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	struct CurveTextError
+	{
+		//  Both starting at 1, 0 when there is no error
+		int line = 0;
+		int column = 0;
+		std::string message;
+	};
+
+	/*
+	 * Single-pass parser of the text format written by curve-x's
+	 * CurveSerializer, reading chunks of any size without building the
+	 * whole file nor any per-line string: only a line split across two
+	 * chunks is carried over.
+	 *
+	 * Grammar, one statement per line, blank lines & lines starting
+	 * with '#' being ignored:
+	 * - 'version:<integer>' (or '=') as the first statement
+	 * - then a key per line, after an optional '<label>:' prefix:
+	 *   '<control.x>,<control.y>,<left.x>,<left.y>,<right.x>,<right.y>,
+	 *   <tangent mode>', numbers being separated by ',' or ';', the
+	 *   tangent mode being its integer or its name and tangents being
+	 *   relative to the control point
+	 *
+	 * Parsing stops at the first error, reported with its line and
+	 * column. The serializer stays the reference of the format: see
+	 * 'is_serializer_compatible' before trusting a parsed curve.
+	 */
+	class CurveTextParser
+	{
+	public:
+		static constexpr int VERSION = 1;
+		static constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+
+	public:
+		/*
+		 * Parses a whole buffer, the curve being only written on
+		 * success.
+		 */
+		bool parse( std::string_view data, Curve* curve );
+		/*
+		 * Reads and parses the file until its end, the descriptor
+		 * staying open.
+		 */
+		bool parse_from_file_descriptor( int file, Curve* curve );
+
+		/*
+		 * Streaming interface: 'begin', then 'feed' chunks until
+		 * the data ends with 'end'. Returns false once an error
+		 * occured.
+		 */
+		void begin();
+		bool feed( std::string_view chunk );
+		bool end( Curve* curve );
+
+		const CurveTextError& get_error() const;
+
+		/*
+		 * Returns whether the parser reads the serializer's output as
+		 * CurveSerializer::unserialize does, checked once on a sample
+		 * curve. Otherwise, the serializer must be used instead.
+		 */
+		static bool is_serializer_compatible();
+
+	private:
+		bool _parse_line( std::string_view line );
+		bool _parse_version( std::string_view line );
+		bool _parse_key( std::string_view line );
+		bool _parse_float( std::string_view line, size_t* offset, float* value );
+		bool _parse_tangent_mode( std::string_view line, size_t* offset, int* value );
+
+		bool _fail( size_t offset, const char* message );
+
+	private:
+		Curve _curve {};
+		std::string _pending_line;
+		int _line = 0;
+		bool _has_version = false;
+		bool _has_failed = false;
+
+		CurveTextError _error {};
+	};
+}
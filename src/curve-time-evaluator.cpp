@@ -0,0 +1,154 @@
+#include "curve-time-evaluator.h"
+
+#include <src/curve-segment.h>
+#include <src/trace.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+void CurveTimeEvaluator::rebuild( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveTimeEvaluator::rebuild" );
+
+	const int keys_count = curve.get_keys_count();
+	const int segments_count = std::max( 0, keys_count - 1 );
+
+	_times.resize( keys_count );
+	for ( std::vector<float>* values : { 
+		&_inverse_durations, &_a, &_b, &_c, &_d } )
+	{
+		values->resize( segments_count );
+	}
+
+	for ( int i = 0; i < keys_count; i++ )
+	{
+		_times[i] = curve.get_key( i ).control.x;
+	}
+	for ( int i = 0; i < segments_count; i++ )
+	{
+		_compute_segment( curve, i );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveTimeEvaluator::update( const Curve& curve )
+{
+	TRACE_SCOPE( "CurveTimeEvaluator::update" );
+
+	const int segments_count = curve.get_keys_count() - 1;
+
+	//  Keys have been added or removed, segments are shifted
+	if ( _dirty_range.is_fully_dirty 
+	  || segments_count != get_segments_count() )
+	{
+		rebuild( curve );
+		return;
+	}
+	if ( !_dirty_range.is_dirty() ) return;
+
+	//  Recompute segments on both sides of the edited keys
+	for ( int i = _dirty_range.first_key_id; i <= _dirty_range.last_key_id; i++ )
+	{
+		_times[i] = curve.get_key( i ).control.x;
+	}
+
+	int first_segment_id, last_segment_id;
+	_dirty_range.get_segments_range( 
+		segments_count, &first_segment_id, &last_segment_id );
+	for ( int i = first_segment_id; i <= last_segment_id; i++ )
+	{
+		_compute_segment( curve, i );
+	}
+
+	_dirty_range.clear();
+}
+
+void CurveTimeEvaluator::invalidate()
+{
+	_dirty_range.invalidate();
+}
+
+void CurveTimeEvaluator::invalidate_key( int key_id )
+{
+	_dirty_range.invalidate_key( key_id );
+}
+
+bool CurveTimeEvaluator::is_dirty() const
+{
+	return _dirty_range.is_dirty();
+}
+
+float CurveTimeEvaluator::evaluate_by_time( float time ) const
+{
+	const int segments_count = get_segments_count();
+	if ( segments_count == 0 ) return 0.0f;
+
+	//  Clamp to first & last keys
+	if ( time <= _times.front() ) return _d.front();
+	if ( time >= _times.back() ) 
+	{
+		const int i = segments_count - 1;
+		return _a[i] + _b[i] + _c[i] + _d[i];
+	}
+
+	const int i = find_segment_by_time( time );
+	const float t = solve_progress( i, time );
+	return ( ( _a[i] * t + _b[i] ) * t + _c[i] ) * t + _d[i];
+}
+
+int CurveTimeEvaluator::find_segment_by_time( float time ) const
+{
+	const int segments_count = get_segments_count();
+	if ( segments_count == 0 ) return 0;
+
+	//  Binary search the first key after the time
+	auto itr = std::upper_bound( _times.begin() + 1, _times.end(), time );
+	const int segment_id = (int)( itr - _times.begin() ) - 1;
+
+	return std::clamp( segment_id, 0, segments_count - 1 );
+}
+
+float CurveTimeEvaluator::solve_progress( int i, float time ) const
+{
+	return std::clamp( ( time - _times[i] ) * _inverse_durations[i], 0.0f, 1.0f );
+}
+
+void CurveTimeEvaluator::get_segment_coefficients( int i, float* coefficients ) const
+{
+	coefficients[0] = _a[i];
+	coefficients[1] = _b[i];
+	coefficients[2] = _c[i];
+	coefficients[3] = _d[i];
+}
+
+float CurveTimeEvaluator::get_key_time( int key_id ) const
+{
+	return _times[key_id];
+}
+
+int CurveTimeEvaluator::get_segments_count() const
+{
+	return (int)_a.size();
+}
+
+void CurveTimeEvaluator::_compute_segment( const Curve& curve, int segment_id )
+{
+	const CurveSegment segment = CurveSegment::from_curve( curve, segment_id );
+	const float p0 = segment.p0.y;
+	const float p1 = segment.p1.y;
+	const float p2 = segment.p2.y;
+	const float p3 = segment.p3.y;
+
+	//  Progress is linear between the keys' times
+	const float duration = segment.p3.x - segment.p0.x;
+	_inverse_durations[segment_id] = duration > 0.0f ? 1.0f / duration : 0.0f;
+
+	//  Bézier to power basis
+	_a[segment_id] = -p0 + 3.0f * p1 - 3.0f * p2 + p3;
+	_b[segment_id] = 3.0f * p0 - 6.0f * p1 + 3.0f * p2;
+	_c[segment_id] = -3.0f * p0 + 3.0f * p1;
+	_d[segment_id] = p0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/dirty-key-range.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Evaluates a curve by time (X-axis) as curve-x's
+	 * Curve::evaluate_by_time does: the progress over the segment
+	 * containing the time is linear between its keys' times, the
+	 * tangents' X-axis being ignored, before evaluating 'y(t)'.
+	 *
+	 * The power-basis cubic coefficients of each segment and the
+	 * inverse of its duration are cached in a structure-of-arrays
+	 * layout, recomputed only for edited keys:
+	 *   t = ( time - time0 ) * inverse_duration
+	 *   y(t) = ( ( a * t + b ) * t + c ) * t + d
+	 */
+	class CurveTimeEvaluator
+	{
+	public:
+		/*
+		 * Recomputes coefficients of all segments of the curve.
+		 */
+		void rebuild( const Curve& curve );
+		/*
+		 * Recomputes coefficients of the segments invalidated since 
+		 * the last update, or rebuilds all of them if it was entirely
+		 * invalidated.
+		 */
+		void update( const Curve& curve );
+
+		/*
+		 * Invalidates all segments.
+		 */
+		void invalidate();
+		/*
+		 * Invalidates the (at most two) segments around a key.
+		 */
+		void invalidate_key( int key_id );
+		bool is_dirty() const;
+
+		/*
+		 * Evaluates the Y-value of the curve at the given time, 
+		 * clamped to the first and last keys.
+		 */
+		float evaluate_by_time( float time ) const;
+
+		/*
+		 * Finds the segment containing the given time with a binary 
+		 * search over the keys.
+		 */
+		int find_segment_by_time( float time ) const;
+		/*
+		 * Returns the progress of the time on a segment, linear
+		 * between its keys' times.
+		 */
+		float solve_progress( int segment_id, float time ) const;
+
+		/*
+		 * Returns the Y-axis power-basis coefficients of a segment,
+		 * ordered by descending degree: { a, b, c, d }.
+		 */
+		void get_segment_coefficients( int segment_id, float* coefficients ) const;
+		float get_key_time( int key_id ) const;
+
+		int get_segments_count() const;
+
+	private:
+		void _compute_segment( const Curve& curve, int segment_id );
+
+	private:
+		//  Time of each key
+		std::vector<float> _times {};
+		//  Inverse duration of each segment, 0.0 if empty
+		std::vector<float> _inverse_durations {};
+
+		std::vector<float> _a {};
+		std::vector<float> _b {};
+		std::vector<float> _c {};
+		std::vector<float> _d {};
+
+		DirtyKeyRange _dirty_range {};
+	};
+}
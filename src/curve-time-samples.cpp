@@ -0,0 +1,86 @@
+#include "curve-time-samples.h"
+
+#include <src/trace.h>
+
+#include <algorithm>
+
+using namespace curve_editor_x;
+
+bool CurveTimeSamples::is_dirty(
+	int revision,
+	float min_time,
+	float max_time,
+	int samples_count
+) const
+{
+	return _revision != revision
+		|| _min_time != min_time
+		|| _max_time != max_time
+		|| _samples_count != samples_count;
+}
+
+void CurveTimeSamples::rebuild(
+	const CurveTimeEvaluator& time_evaluator,
+	int revision,
+	float min_time,
+	float max_time,
+	int samples_count
+)
+{
+	TRACE_SCOPE( "CurveTimeSamples::rebuild" );
+
+	_points.clear();
+	_revision = revision;
+	_min_time = min_time;
+	_max_time = max_time;
+	_samples_count = samples_count;
+
+	const int segments_count = time_evaluator.get_segments_count();
+	if ( segments_count == 0 ) return;
+
+	//  Clamp to the curve's keys
+	min_time = std::max( min_time, time_evaluator.get_key_time( 0 ) );
+	max_time = std::min( max_time, time_evaluator.get_key_time( segments_count ) );
+	if ( max_time < min_time ) return;
+
+	samples_count = std::max( 2, samples_count );
+
+	//  Find keys strictly inside the interval, only inserted if they
+	//  are not denser than the samples
+	int key_id = time_evaluator.find_segment_by_time( min_time ) + 1;
+	const int last_key_id = time_evaluator.find_segment_by_time( max_time );
+	const bool has_keys = last_key_id - key_id + 1 <= samples_count;
+
+	_points.reserve( samples_count + ( has_keys ? last_key_id - key_id + 1 : 0 ) );
+
+	const float step = ( max_time - min_time ) / (float)( samples_count - 1 );
+	for ( int i = 0; i < samples_count; i++ )
+	{
+		const float time = i == samples_count - 1
+			? max_time
+			: min_time + step * (float)i;
+
+		//  Insert keys preceding the sample
+		while ( has_keys && key_id <= last_key_id )
+		{
+			const float key_time = time_evaluator.get_key_time( key_id );
+			if ( key_time >= time ) break;
+
+			if ( key_time > min_time )
+			{
+				_points.push_back( Point {
+					key_time,
+					time_evaluator.evaluate_by_time( key_time ),
+				} );
+			}
+			key_id++;
+		}
+
+		_points.push_back( Point { time, time_evaluator.evaluate_by_time( time ) } );
+	}
+}
+
+const std::vector<Point>& CurveTimeSamples::get_points() const
+{
+	return _points;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include <curve-x/curve.h>
+
+#include <src/curve-time-evaluator.h>
+
+namespace curve_editor_x
+{
+	using namespace curve_x;
+
+	/*
+	 * Time-evaluated samples of a curve over an interval, typically
+	 * the visible one.
+	 *
+	 * Samples are evenly spread over the interval, so that their
+	 * count follows the on-screen pixels instead of the curve's keys
+	 * and the cost stays constant at any zoom. Keys inside the interval
+	 * are inserted as extra samples when they are fewer than the
+	 * samples, keeping corners sharp.
+	 */
+	class CurveTimeSamples
+	{
+	public:
+		/*
+		 * Returns whether the samples are out-of-date for the given
+		 * curve revision, interval and samples count.
+		 */
+		bool is_dirty(
+			int revision,
+			float min_time,
+			float max_time,
+			int samples_count
+		) const;
+
+		/*
+		 * Samples the curve between the given times, clamped to its
+		 * first and last keys.
+		 */
+		void rebuild(
+			const CurveTimeEvaluator& time_evaluator,
+			int revision,
+			float min_time,
+			float max_time,
+			int samples_count
+		);
+
+		const std::vector<Point>& get_points() const;
+
+	private:
+		std::vector<Point> _points {};
+
+		int _revision = -1;
+		float _min_time = 0.0f;
+		float _max_time = 0.0f;
+		int _samples_count = 0;
+	};
+}
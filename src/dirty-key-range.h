@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+
+namespace curve_editor_x
+{
+	/*
+	 * Tracks which keys of a curve have been edited since a cached
+	 * data was last updated, so that only the segments around them
+	 * need to be recomputed.
+	 */
+	struct DirtyKeyRange
+	{
+	public:
+		/*
+		 * Invalidates the whole curve.
+		 */
+		void invalidate()
+		{
+			is_fully_dirty = true;
+		}
+
+		void invalidate_key( int key_id )
+		{
+			if ( first_key_id < 0 )
+			{
+				first_key_id = key_id;
+				last_key_id = key_id;
+				return;
+			}
+
+			first_key_id = std::min( first_key_id, key_id );
+			last_key_id = std::max( last_key_id, key_id );
+		}
+
+		void clear()
+		{
+			is_fully_dirty = false;
+			first_key_id = -1;
+			last_key_id = -1;
+		}
+
+		bool is_dirty() const
+		{
+			return is_fully_dirty || first_key_id >= 0;
+		}
+
+		/*
+		 * Returns the segments on both sides of the edited keys.
+		 */
+		void get_segments_range(
+			int segments_count,
+			int* first_segment_id,
+			int* last_segment_id
+		) const
+		{
+			*first_segment_id = std::max( 0, first_key_id - 1 );
+			*last_segment_id = std::min( segments_count - 1, last_key_id );
+		}
+
+	public:
+		bool is_fully_dirty = true;
+		int first_key_id = -1;
+		int last_key_id = -1;
+	};
+}
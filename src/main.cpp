@@ -42,6 +42,8 @@
  //  Includes
 
 #include <src/application.h>
+#include <src/settings.h>
+#include <src/profiler.h>
 
 using namespace curve_editor_x;
 
@@ -61,23 +63,58 @@ int main( void )
 	InitWindow( WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE );
 	SetTargetFPS( WINDOW_TARGET_FPS );
 
-	Application application( 
-		Rectangle {
-			WINDOW_PADDING,
-			WINDOW_PADDING,
-			WINDOW_WIDTH - WINDOW_PADDING * 2.0f,
-			WINDOW_HEIGHT - WINDOW_PADDING * 2.0f,
-		} 
-	);
-	application.init();
-
-	while ( !WindowShouldClose() )
+	//  Sleep until the next input event at the end of a frame
+	if ( settings::ENABLE_ON_DEMAND_RENDERING )
 	{
-		application.update( GetFrameTime() );
+		EnableEventWaiting();
+	}
+
+	//  Scoped to release GPU resources before closing the window
+	{
+		Application application( 
+			Rectangle {
+				WINDOW_PADDING,
+				WINDOW_PADDING,
+				WINDOW_WIDTH - WINDOW_PADDING * 2.0f,
+				WINDOW_HEIGHT - WINDOW_PADDING * 2.0f,
+			} 
+		);
+		application.init();
+
+		while ( !WindowShouldClose() )
+		{
+			Profiler::begin_frame();
+			application.update( GetFrameTime() );
+
+			//  Keep frames coming while working in the background
+			if ( settings::ENABLE_ON_DEMAND_RENDERING )
+			{
+				if ( application.is_busy() )
+				{
+					DisableEventWaiting();
+				}
+				else
+				{
+					EnableEventWaiting();
+				}
+			}
 
-		BeginDrawing();
-		application.render();
-		EndDrawing();
+			if ( !settings::ENABLE_ON_DEMAND_RENDERING 
+			  || application.is_dirty() )
+			{
+				BeginDrawing();
+				application.render();
+				//  Measure CPU time only, not the swap & frame limiting
+				Profiler::end_frame();
+				EndDrawing();
+			}
+			else
+			{
+				//  Nothing changed, keep the last frame and wait for
+				//  the next events
+				PollInputEvents();
+			}
+		}
 	}
 
 	CloseWindow();
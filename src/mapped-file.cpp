@@ -0,0 +1,141 @@
+#include "mapped-file.h"
+
+//  Kept apart from raylib, whose names collide with Windows' ones
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace curve_editor_x;
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open( const std::string& path )
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file_handle = CreateFileA(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		NULL
+	);
+	if ( file_handle == INVALID_HANDLE_VALUE ) return false;
+
+	LARGE_INTEGER size {};
+	if ( !GetFileSizeEx( file_handle, &size ) )
+	{
+		CloseHandle( file_handle );
+		return false;
+	}
+
+	_file_handle = file_handle;
+	_size = (size_t)size.QuadPart;
+	_is_open = true;
+
+	//  Empty files can't be mapped
+	if ( _size == 0 ) return true;
+
+	HANDLE mapping_handle = CreateFileMappingA(
+		file_handle, NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( mapping_handle == NULL )
+	{
+		close();
+		return false;
+	}
+	_mapping_handle = mapping_handle;
+
+	_data = MapViewOfFile( mapping_handle, FILE_MAP_READ, 0, 0, 0 );
+	if ( _data == nullptr )
+	{
+		close();
+		return false;
+	}
+#else
+	const int file = ::open( path.c_str(), O_RDONLY );
+	if ( file < 0 ) return false;
+
+	struct stat file_stat {};
+	if ( fstat( file, &file_stat ) != 0 )
+	{
+		::close( file );
+		return false;
+	}
+
+	_size = (size_t)file_stat.st_size;
+	_is_open = true;
+
+	//  Empty files can't be mapped
+	if ( _size > 0 )
+	{
+		void* data = mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0 );
+		if ( data == MAP_FAILED )
+		{
+			::close( file );
+			close();
+			return false;
+		}
+		_data = data;
+	}
+
+	//  The mapping keeps the file's content alive
+	::close( file );
+#endif
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if ( _data != nullptr )
+	{
+		UnmapViewOfFile( _data );
+	}
+	if ( _mapping_handle != nullptr )
+	{
+		CloseHandle( (HANDLE)_mapping_handle );
+		_mapping_handle = nullptr;
+	}
+	if ( _file_handle != nullptr )
+	{
+		CloseHandle( (HANDLE)_file_handle );
+		_file_handle = nullptr;
+	}
+#else
+	if ( _data != nullptr )
+	{
+		munmap( (void*)_data, _size );
+	}
+#endif
+
+	_data = nullptr;
+	_size = 0;
+	_is_open = false;
+}
+
+bool MappedFile::is_open() const
+{
+	return _is_open;
+}
+
+const void* MappedFile::get_data() const
+{
+	return _data;
+}
+
+size_t MappedFile::get_size() const
+{
+	return _size;
+}
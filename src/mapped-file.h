@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace curve_editor_x
+{
+	/*
+	 * Read-only memory mapping of a whole file, unmapped on
+	 * destruction.
+	 *
+	 * Supported OS: Windows & POSIX
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() {}
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+		~MappedFile();
+
+		/*
+		 * Maps the file, closing the previous one. Returns false if
+		 * the file can't be opened.
+		 */
+		bool open( const std::string& path );
+		void close();
+
+		bool is_open() const;
+		/*
+		 * Returns the file's content, page-aligned, or nullptr if
+		 * the file is empty.
+		 */
+		const void* get_data() const;
+		size_t get_size() const;
+
+	private:
+		const void* _data = nullptr;
+		size_t _size = 0;
+		bool _is_open = false;
+
+#ifdef _WIN32
+		void* _file_handle = nullptr;
+		void* _mapping_handle = nullptr;
+#endif
+	};
+}
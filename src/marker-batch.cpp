@@ -0,0 +1,247 @@
+#include "marker-batch.h"
+
+#include <src/settings.h>
+#include <src/profiler.h>
+
+#include <rlgl.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+//  Vertices submitted per rlgl batch, a multiple of 3
+constexpr int BATCH_VERTICES_COUNT = 3 * 1024;
+constexpr int CIRCLE_SEGMENTS = settings::MARKER_CIRCLE_SEGMENTS;
+
+/*
+ * Returns the points of a unit circle, the first one repeated at
+ * the end.
+ */
+static const Vector2* get_unit_circle()
+{
+	static Vector2 points[CIRCLE_SEGMENTS + 1] {};
+	static bool is_computed = false;
+
+	if ( !is_computed )
+	{
+		for ( int i = 0; i <= CIRCLE_SEGMENTS; i++ )
+		{
+			const float angle = 2.0f * PI * (float)( i % CIRCLE_SEGMENTS )
+				/ (float)CIRCLE_SEGMENTS;
+			points[i] = Vector2 { cosf( angle ), sinf( angle ) };
+		}
+		is_computed = true;
+	}
+
+	return points;
+}
+
+void MarkerBatch::clear()
+{
+	_vertices.clear();
+}
+
+void MarkerBatch::add_line(
+	const Vector2& start,
+	const Vector2& end,
+	float thickness,
+	const Color& color
+)
+{
+	const float dx = end.x - start.x;
+	const float dy = end.y - start.y;
+	const float length = sqrtf( dx * dx + dy * dy );
+	if ( length <= 0.0f ) return;
+
+	const float scale = thickness * 0.5f / length;
+	const Vector2 offset { -dy * scale, dx * scale };
+
+	_add_quad(
+		Vector2 { start.x + offset.x, start.y + offset.y },
+		Vector2 { end.x + offset.x, end.y + offset.y },
+		Vector2 { end.x - offset.x, end.y - offset.y },
+		Vector2 { start.x - offset.x, start.y - offset.y },
+		color
+	);
+}
+
+void MarkerBatch::add_circle(
+	const Vector2& center,
+	float radius,
+	const Color& color
+)
+{
+	const Vector2* circle = get_unit_circle();
+	for ( int i = 0; i < CIRCLE_SEGMENTS; i++ )
+	{
+		_add_triangle(
+			center,
+			Vector2 {
+				center.x + circle[i].x * radius,
+				center.y + circle[i].y * radius
+			},
+			Vector2 {
+				center.x + circle[i + 1].x * radius,
+				center.y + circle[i + 1].y * radius
+			},
+			color
+		);
+	}
+}
+
+void MarkerBatch::add_ring(
+	const Vector2& center,
+	float radius,
+	float thickness,
+	const Color& color
+)
+{
+	const float inner_radius = std::max( 0.0f, radius - thickness );
+
+	const Vector2* circle = get_unit_circle();
+	for ( int i = 0; i < CIRCLE_SEGMENTS; i++ )
+	{
+		_add_quad(
+			Vector2 {
+				center.x + circle[i].x * radius,
+				center.y + circle[i].y * radius
+			},
+			Vector2 {
+				center.x + circle[i + 1].x * radius,
+				center.y + circle[i + 1].y * radius
+			},
+			Vector2 {
+				center.x + circle[i + 1].x * inner_radius,
+				center.y + circle[i + 1].y * inner_radius
+			},
+			Vector2 {
+				center.x + circle[i].x * inner_radius,
+				center.y + circle[i].y * inner_radius
+			},
+			color
+		);
+	}
+}
+
+void MarkerBatch::add_square(
+	const Vector2& center,
+	float size,
+	const Color& color
+)
+{
+	const float half_size = size * 0.5f;
+
+	_add_quad(
+		Vector2 { center.x - half_size, center.y - half_size },
+		Vector2 { center.x + half_size, center.y - half_size },
+		Vector2 { center.x + half_size, center.y + half_size },
+		Vector2 { center.x - half_size, center.y + half_size },
+		color
+	);
+}
+
+void MarkerBatch::add_square_lines(
+	const Vector2& center,
+	float size,
+	float thickness,
+	const Color& color
+)
+{
+	const float half_size = size * 0.5f;
+	const float left = center.x - half_size;
+	const float right = center.x + half_size;
+	const float top = center.y - half_size;
+	const float bottom = center.y + half_size;
+
+	//  Top & bottom sides over the whole width
+	_add_quad(
+		Vector2 { left, top }, Vector2 { right, top },
+		Vector2 { right, top + thickness }, Vector2 { left, top + thickness },
+		color
+	);
+	_add_quad(
+		Vector2 { left, bottom - thickness }, Vector2 { right, bottom - thickness },
+		Vector2 { right, bottom }, Vector2 { left, bottom },
+		color
+	);
+
+	//  Left & right sides in-between
+	_add_quad(
+		Vector2 { left, top + thickness },
+		Vector2 { left + thickness, top + thickness },
+		Vector2 { left + thickness, bottom - thickness },
+		Vector2 { left, bottom - thickness },
+		color
+	);
+	_add_quad(
+		Vector2 { right - thickness, top + thickness },
+		Vector2 { right, top + thickness },
+		Vector2 { right, bottom - thickness },
+		Vector2 { right - thickness, bottom - thickness },
+		color
+	);
+}
+
+void MarkerBatch::render() const
+{
+	ProfilerScope scope( "Draw submission" );
+
+	const int vertices_count = (int)_vertices.size();
+	for ( int first = 0; first < vertices_count; first += BATCH_VERTICES_COUNT )
+	{
+		const int last = std::min( first + BATCH_VERTICES_COUNT, vertices_count );
+
+		//  Flush the current batch if it can't hold the chunk
+		rlCheckRenderBatchLimit( last - first );
+
+		rlBegin( RL_TRIANGLES );
+		for ( int i = first; i < last; i++ )
+		{
+			const Vertex& vertex = _vertices[i];
+			rlColor4ub(
+				vertex.color.r, vertex.color.g,
+				vertex.color.b, vertex.color.a
+			);
+			rlVertex2f( vertex.pos.x, vertex.pos.y );
+		}
+		rlEnd();
+		Profiler::add_count( "Draw submissions", 1 );
+	}
+}
+
+void MarkerBatch::_add_triangle(
+	const Vector2& a,
+	const Vector2& b,
+	const Vector2& c,
+	const Color& color
+)
+{
+	//  Keep counter-clockwise order on screen (Y-axis pointing down),
+	//  otherwise triangles are culled as back faces
+	const float cross = ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+
+	_vertices.push_back( Vertex { a, color } );
+	if ( cross > 0.0f )
+	{
+		_vertices.push_back( Vertex { c, color } );
+		_vertices.push_back( Vertex { b, color } );
+	}
+	else
+	{
+		_vertices.push_back( Vertex { b, color } );
+		_vertices.push_back( Vertex { c, color } );
+	}
+}
+
+void MarkerBatch::_add_quad(
+	const Vector2& a,
+	const Vector2& b,
+	const Vector2& c,
+	const Vector2& d,
+	const Color& color
+)
+{
+	_add_triangle( a, b, c, color );
+	_add_triangle( a, c, d, color );
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+
+namespace curve_editor_x
+{
+	/*
+	 * Colored triangles of editor markers (points, selection rings
+	 * and tangent lines), built into a single vertex stream and
+	 * submitted to raylib in a few rlgl batches instead of a draw
+	 * call per shape.
+	 */
+	class MarkerBatch
+	{
+	public:
+		/*
+		 * Removes all triangles, keeping the allocated memory.
+		 */
+		void clear();
+
+		void add_line(
+			const Vector2& start,
+			const Vector2& end,
+			float thickness,
+			const Color& color
+		);
+		void add_circle(
+			const Vector2& center,
+			float radius,
+			const Color& color
+		);
+		/*
+		 * Adds a circle outline, the thickness growing inward.
+		 */
+		void add_ring(
+			const Vector2& center,
+			float radius,
+			float thickness,
+			const Color& color
+		);
+		void add_square(
+			const Vector2& center,
+			float size,
+			const Color& color
+		);
+		/*
+		 * Adds a square outline, the thickness growing inward.
+		 */
+		void add_square_lines(
+			const Vector2& center,
+			float size,
+			float thickness,
+			const Color& color
+		);
+
+		/*
+		 * Submits the triangles to the current render batch.
+		 */
+		void render() const;
+
+	private:
+		struct Vertex
+		{
+			Vector2 pos;
+			Color color;
+		};
+
+		void _add_triangle(
+			const Vector2& a,
+			const Vector2& b,
+			const Vector2& c,
+			const Color& color
+		);
+		void _add_quad(
+			const Vector2& a,
+			const Vector2& b,
+			const Vector2& c,
+			const Vector2& d,
+			const Color& color
+		);
+
+	private:
+		//  Three vertices per triangle
+		std::vector<Vertex> _vertices {};
+	};
+}
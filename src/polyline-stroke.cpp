@@ -0,0 +1,191 @@
+#include "polyline-stroke.h"
+
+#include <rlgl.h>
+
+#include <src/profiler.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace curve_editor_x;
+
+//  Vertices submitted per rlgl batch, a multiple of 3
+constexpr int BATCH_VERTICES_COUNT = 3 * 1024;
+//  Squared distance under which consecutive points are merged
+constexpr float DUPLICATE_DISTANCE_SQR = 1e-6f;
+
+void PolylineStroke::clear()
+{
+	_vertices.clear();
+}
+
+void PolylineStroke::add_polyline(
+	const Vector2* points,
+	int points_count,
+	float thickness,
+	float miter_limit
+)
+{
+	//  Skip duplicated points, they don't have any direction
+	_points.clear();
+	for ( int i = 0; i < points_count; i++ )
+	{
+		if ( !_points.empty() )
+		{
+			const float dx = points[i].x - _points.back().x;
+			const float dy = points[i].y - _points.back().y;
+			if ( dx * dx + dy * dy <= DUPLICATE_DISTANCE_SQR ) continue;
+		}
+
+		_points.push_back( points[i] );
+	}
+
+	const int count = (int)_points.size();
+	if ( count < 2 ) return;
+
+	const float half_thickness = thickness * 0.5f;
+	//  Miter ratio is 'sqrt( 2 / ( 1 + dot ) )' for unit normals
+	const float min_miter_dot = 2.0f / ( miter_limit * miter_limit ) - 1.0f;
+
+	Vector2 normal = _get_normal( _points[0], _points[1] );
+	Vector2 start_left {
+		_points[0].x + normal.x * half_thickness,
+		_points[0].y + normal.y * half_thickness,
+	};
+	Vector2 start_right {
+		_points[0].x - normal.x * half_thickness,
+		_points[0].y - normal.y * half_thickness,
+	};
+
+	for ( int i = 1; i < count; i++ )
+	{
+		const Vector2& pos = _points[i];
+
+		//  End the line squared, unless joined with a miter
+		Vector2 offset {
+			normal.x * half_thickness,
+			normal.y * half_thickness,
+		};
+		Vector2 next_normal = normal;
+		bool is_beveled = false;
+		if ( i < count - 1 )
+		{
+			next_normal = _get_normal( pos, _points[i + 1] );
+
+			const float dot = normal.x * next_normal.x + normal.y * next_normal.y;
+			if ( dot >= min_miter_dot )
+			{
+				const float scale = half_thickness / ( 1.0f + dot );
+				offset.x = ( normal.x + next_normal.x ) * scale;
+				offset.y = ( normal.y + next_normal.y ) * scale;
+			}
+			else
+			{
+				is_beveled = true;
+			}
+		}
+
+		const Vector2 end_left { pos.x + offset.x, pos.y + offset.y };
+		const Vector2 end_right { pos.x - offset.x, pos.y - offset.y };
+		_add_quad( start_left, end_left, end_right, start_right );
+
+		if ( is_beveled )
+		{
+			//  Fill the outer side of the turn
+			const float cross = normal.x * next_normal.y - normal.y * next_normal.x;
+			const float side = cross > 0.0f ? -half_thickness : half_thickness;
+			_add_triangle(
+				pos,
+				Vector2 { pos.x + normal.x * side, pos.y + normal.y * side },
+				Vector2 { pos.x + next_normal.x * side, pos.y + next_normal.y * side }
+			);
+
+			start_left = Vector2 {
+				pos.x + next_normal.x * half_thickness,
+				pos.y + next_normal.y * half_thickness,
+			};
+			start_right = Vector2 {
+				pos.x - next_normal.x * half_thickness,
+				pos.y - next_normal.y * half_thickness,
+			};
+		}
+		else
+		{
+			start_left = end_left;
+			start_right = end_right;
+		}
+
+		normal = next_normal;
+	}
+}
+
+void PolylineStroke::render( const Color& color ) const
+{
+	ProfilerScope scope( "Draw submission" );
+
+	const int vertices_count = (int)_vertices.size();
+	for ( int first = 0; first < vertices_count; first += BATCH_VERTICES_COUNT )
+	{
+		const int last = std::min( first + BATCH_VERTICES_COUNT, vertices_count );
+
+		//  Flush the current batch if it can't hold the chunk
+		rlCheckRenderBatchLimit( last - first );
+
+		rlBegin( RL_TRIANGLES );
+		rlColor4ub( color.r, color.g, color.b, color.a );
+		for ( int i = first; i < last; i++ )
+		{
+			rlVertex2f( _vertices[i].x, _vertices[i].y );
+		}
+		rlEnd();
+		Profiler::add_count( "Draw submissions", 1 );
+	}
+}
+
+const std::vector<Vector2>& PolylineStroke::get_vertices() const
+{
+	return _vertices;
+}
+
+void PolylineStroke::_add_triangle(
+	const Vector2& a,
+	const Vector2& b,
+	const Vector2& c
+)
+{
+	//  Keep counter-clockwise order on screen (Y-axis pointing down),
+	//  otherwise triangles are culled as back faces
+	const float cross = ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+
+	_vertices.push_back( a );
+	if ( cross > 0.0f )
+	{
+		_vertices.push_back( c );
+		_vertices.push_back( b );
+	}
+	else
+	{
+		_vertices.push_back( b );
+		_vertices.push_back( c );
+	}
+}
+
+void PolylineStroke::_add_quad(
+	const Vector2& a,
+	const Vector2& b,
+	const Vector2& c,
+	const Vector2& d
+)
+{
+	_add_triangle( a, b, c );
+	_add_triangle( a, c, d );
+}
+
+Vector2 PolylineStroke::_get_normal( const Vector2& a, const Vector2& b )
+{
+	const float dx = b.x - a.x;
+	const float dy = b.y - a.y;
+	const float length = sqrtf( dx * dx + dy * dy );
+
+	return Vector2 { -dy / length, dx / length };
+}
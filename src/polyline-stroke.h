@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+
+namespace curve_editor_x
+{
+	/*
+	 * Triangles of thick screen-space polylines, submitted to raylib
+	 * in a few rlgl batches instead of a quad per line.
+	 *
+	 * Consecutive lines are joined with miters, beveled when the
+	 * miter exceeds the limit. Vertices are kept between frames so
+	 * that an unchanged stroke is only re-submitted.
+	 */
+	class PolylineStroke
+	{
+	public:
+		/*
+		 * Removes all triangles, keeping the allocated memory.
+		 */
+		void clear();
+
+		/*
+		 * Appends the stroke of a polyline. The miter limit is the
+		 * maximum ratio between a miter length and the half thickness.
+		 */
+		void add_polyline(
+			const Vector2* points,
+			int points_count,
+			float thickness,
+			float miter_limit
+		);
+
+		/*
+		 * Submits the triangles to the current render batch.
+		 */
+		void render( const Color& color ) const;
+
+		const std::vector<Vector2>& get_vertices() const;
+
+	private:
+		void _add_triangle(
+			const Vector2& a,
+			const Vector2& b,
+			const Vector2& c
+		);
+		void _add_quad(
+			const Vector2& a,
+			const Vector2& b,
+			const Vector2& c,
+			const Vector2& d
+		);
+
+		static Vector2 _get_normal( const Vector2& a, const Vector2& b );
+
+	private:
+		//  Three vertices per triangle
+		std::vector<Vector2> _vertices {};
+		//  Points of the polyline being added, without duplicates
+		std::vector<Vector2> _points {};
+	};
+}
@@ -0,0 +1,230 @@
+#include "profiler.h"
+
+#include <src/settings.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace curve_editor_x;
+
+bool Profiler::_is_enabled = false;
+Profiler::Clock::time_point Profiler::_frame_start_time {};
+std::vector<Profiler::Entry> Profiler::_entries {};
+std::vector<Profiler::Entry> Profiler::_last_entries {};
+std::vector<float> Profiler::_frame_times {};
+int Profiler::_frame_time_id = 0;
+std::vector<float> Profiler::_sorted_frame_times {};
+
+/*
+ * Returns whether two optional literals are equal.
+ */
+static bool is_same_text( const char* a, const char* b )
+{
+	if ( a == b ) return true;
+	if ( a == nullptr || b == nullptr ) return false;
+
+	return strcmp( a, b ) == 0;
+}
+
+void Profiler::set_enabled( bool is_enabled )
+{
+	_is_enabled = is_enabled;
+
+	//  Don't mix frames from another session
+	_entries.clear();
+	_last_entries.clear();
+	_frame_times.clear();
+	_frame_time_id = 0;
+}
+
+bool Profiler::is_enabled()
+{
+	return _is_enabled;
+}
+
+void Profiler::begin_frame()
+{
+	if ( !_is_enabled ) return;
+
+	//  Keep entries so that the overlay has a stable order
+	for ( Entry& entry : _entries )
+	{
+		entry.time = 0.0;
+		entry.count = 0;
+		entry.depth = 0;
+	}
+
+	_frame_start_time = Clock::now();
+}
+
+void Profiler::end_frame()
+{
+	if ( !_is_enabled ) return;
+
+	const std::chrono::duration<float, std::milli> frame_time =
+		Clock::now() - _frame_start_time;
+
+	//  Add to history
+	if ( (int)_frame_times.size() < settings::PROFILER_HISTORY_SIZE )
+	{
+		_frame_times.push_back( frame_time.count() );
+	}
+	else
+	{
+		_frame_times[_frame_time_id] = frame_time.count();
+	}
+	_frame_time_id = ( _frame_time_id + 1 ) % settings::PROFILER_HISTORY_SIZE;
+
+	_last_entries = _entries;
+
+	_sorted_frame_times = _frame_times;
+	std::sort( _sorted_frame_times.begin(), _sorted_frame_times.end() );
+}
+
+void Profiler::begin_scope( const char* name, const char* tag )
+{
+	if ( !_is_enabled ) return;
+
+	Entry& entry = _find_entry( name, tag, false );
+	if ( entry.depth++ == 0 )
+	{
+		entry.start_time = Clock::now();
+	}
+}
+
+void Profiler::end_scope( const char* name, const char* tag )
+{
+	if ( !_is_enabled ) return;
+
+	Entry& entry = _find_entry( name, tag, false );
+	if ( entry.depth == 0 ) return;
+	if ( --entry.depth > 0 ) return;
+
+	const std::chrono::duration<double, std::milli> time =
+		Clock::now() - entry.start_time;
+	entry.time += time.count();
+	entry.count++;
+}
+
+void Profiler::add_count( const char* name, int count )
+{
+	if ( !_is_enabled ) return;
+
+	_find_entry( name, nullptr, true ).count += count;
+}
+
+void Profiler::render( const Vector2& pos )
+{
+	if ( !_is_enabled ) return;
+
+	const float font_size = settings::PROFILER_FONT_SIZE;
+	const float line_height = font_size + 2.0f;
+	const float padding = 4.0f;
+	const float graph_height = settings::PROFILER_GRAPH_HEIGHT;
+	const float bar_width = 1.0f;
+	const float width = std::max(
+		220.0f, settings::PROFILER_HISTORY_SIZE * bar_width ) + padding * 2.0f;
+	const float height = padding * 3.0f + graph_height
+		+ line_height * (float)( _last_entries.size() + 1 );
+
+	DrawRectangleRec(
+		Rectangle { pos.x, pos.y, width, height },
+		settings::PROFILER_BACKGROUND_COLOR
+	);
+
+	//  Draw percentiles
+	Vector2 text_pos { pos.x + padding, pos.y + padding };
+	DrawText(
+		TextFormat( "frame: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms",
+			_get_percentile( 0.50f ),
+			_get_percentile( 0.95f ),
+			_get_percentile( 0.99f ) ),
+		(int)text_pos.x, (int)text_pos.y,
+		(int)font_size,
+		settings::PROFILER_TEXT_COLOR
+	);
+	text_pos.y += line_height;
+
+	//  Draw entries
+	for ( const Entry& entry : _last_entries )
+	{
+		const char* label = entry.tag == nullptr
+			? entry.name
+			: TextFormat( "%s %s", entry.name, entry.tag );
+		const char* text = entry.is_counter
+			? TextFormat( "%s: %d", label, entry.count )
+			: TextFormat( "%s: %.3f ms (x%d)", label, entry.time, entry.count );
+
+		DrawText(
+			text,
+			(int)text_pos.x, (int)text_pos.y,
+			(int)font_size,
+			settings::PROFILER_TEXT_COLOR
+		);
+		text_pos.y += line_height;
+	}
+
+	//  Draw frame times graph, oldest on the left
+	const float graph_bottom = text_pos.y + padding + graph_height;
+	const float max_time = std::max(
+		settings::PROFILER_GRAPH_MAX_TIME,
+		_sorted_frame_times.empty() ? 0.0f : _sorted_frame_times.back()
+	);
+	const int frames_count = (int)_frame_times.size();
+	for ( int i = 0; i < frames_count; i++ )
+	{
+		const int frame_id = frames_count < settings::PROFILER_HISTORY_SIZE
+			? i
+			: ( _frame_time_id + i ) % frames_count;
+		const float bar_height = _frame_times[frame_id] / max_time * graph_height;
+
+		DrawRectangleRec(
+			Rectangle {
+				text_pos.x + (float)i * bar_width,
+				graph_bottom - bar_height,
+				bar_width,
+				bar_height,
+			},
+			settings::PROFILER_GRAPH_COLOR
+		);
+	}
+
+	//  Draw the 60 FPS budget
+	const float budget_y = graph_bottom
+		- 1000.0f / 60.0f / max_time * graph_height;
+	DrawLineEx(
+		Vector2 { text_pos.x, budget_y },
+		Vector2 { pos.x + width - padding, budget_y },
+		1.0f,
+		settings::PROFILER_TEXT_COLOR
+	);
+}
+
+Profiler::Entry& Profiler::_find_entry(
+	const char* name,
+	const char* tag,
+	bool is_counter
+)
+{
+	for ( Entry& entry : _entries )
+	{
+		if ( entry.is_counter == is_counter
+		  && is_same_text( entry.name, name )
+		  && is_same_text( entry.tag, tag ) ) return entry;
+	}
+
+	Entry entry {};
+	entry.name = name;
+	entry.tag = tag;
+	entry.is_counter = is_counter;
+	_entries.push_back( entry );
+	return _entries.back();
+}
+
+float Profiler::_get_percentile( float percentile )
+{
+	if ( _sorted_frame_times.empty() ) return 0.0f;
+
+	const int id = (int)( percentile * (float)( _sorted_frame_times.size() - 1 ) + 0.5f );
+	return _sorted_frame_times[id];
+}
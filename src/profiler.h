@@ -0,0 +1,102 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <chrono>
+#include <vector>
+
+namespace curve_editor_x
+{
+	/*
+	 * CPU timings and counters of the current frame, displayed as an
+	 * overlay along with a history of frame times.
+	 *
+	 * Entries are identified by a name and an optional tag, both
+	 * expected to be string literals. Measuring does nothing unless
+	 * the profiler is enabled.
+	 */
+	class Profiler
+	{
+	public:
+		static void set_enabled( bool is_enabled );
+		static bool is_enabled();
+
+		/*
+		 * Resets the timings and counters of the frame.
+		 */
+		static void begin_frame();
+		/*
+		 * Keeps the timings and counters of the frame for the overlay
+		 * and adds its duration to the history.
+		 */
+		static void end_frame();
+
+		static void begin_scope( const char* name, const char* tag );
+		static void end_scope( const char* name, const char* tag );
+		static void add_count( const char* name, int count );
+
+		/*
+		 * Draws timings & counters of the last frame and the graph of
+		 * the last frame times with their percentiles.
+		 */
+		static void render( const Vector2& pos );
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Entry
+		{
+			const char* name = nullptr;
+			const char* tag = nullptr;
+			bool is_counter = false;
+
+			double time = 0.0;
+			int count = 0;
+
+			//  Nested scopes of the same entry are only measured once
+			int depth = 0;
+			Clock::time_point start_time {};
+		};
+
+		static Entry& _find_entry(
+			const char* name,
+			const char* tag,
+			bool is_counter
+		);
+		static float _get_percentile( float percentile );
+
+	private:
+		static bool _is_enabled;
+
+		static Clock::time_point _frame_start_time;
+		static std::vector<Entry> _entries;
+		//  Entries of the last ended frame
+		static std::vector<Entry> _last_entries;
+
+		//  Ring buffer of the last frame times, in milliseconds
+		static std::vector<float> _frame_times;
+		static int _frame_time_id;
+		static std::vector<float> _sorted_frame_times;
+	};
+
+	/*
+	 * Measures its lifetime into a profiler entry.
+	 */
+	class ProfilerScope
+	{
+	public:
+		ProfilerScope( const char* name, const char* tag = nullptr )
+			: _name( name ), _tag( tag )
+		{
+			Profiler::begin_scope( _name, _tag );
+		}
+		~ProfilerScope()
+		{
+			Profiler::end_scope( _name, _tag );
+		}
+
+	private:
+		const char* _name = nullptr;
+		const char* _tag = nullptr;
+	};
+}
@@ -0,0 +1,78 @@
+#include "screen-point-grid.h"
+
+#include <cmath>
+
+using namespace curve_editor_x;
+
+void ScreenPointGrid::clear( float cell_size )
+{
+	_cell_size = cell_size;
+
+	//  Keep the buckets' memory for the next rebuild, dropping the
+	//  ones left unused by the last one so panning doesn't grow the
+	//  map forever
+	for ( auto itr = _cells.begin(); itr != _cells.end(); )
+	{
+		if ( itr->second.empty() )
+		{
+			itr = _cells.erase( itr );
+			continue;
+		}
+
+		itr->second.clear();
+		itr++;
+	}
+}
+
+void ScreenPointGrid::add_point( int point_id, const Vector2& pos )
+{
+	const long long key = _get_cell_key(
+		_get_cell_coordinate( pos.x ),
+		_get_cell_coordinate( pos.y )
+	);
+	_cells[key].push_back( Entry { point_id, pos } );
+}
+
+int ScreenPointGrid::find_point_at( const Vector2& pos, float radius ) const
+{
+	const int min_cell_x = _get_cell_coordinate( pos.x - radius );
+	const int max_cell_x = _get_cell_coordinate( pos.x + radius );
+	const int min_cell_y = _get_cell_coordinate( pos.y - radius );
+	const int max_cell_y = _get_cell_coordinate( pos.y + radius );
+	const float radius_sqr = radius * radius;
+
+	int found_point_id = -1;
+	for ( int cell_x = min_cell_x; cell_x <= max_cell_x; cell_x++ )
+	{
+		for ( int cell_y = min_cell_y; cell_y <= max_cell_y; cell_y++ )
+		{
+			auto itr = _cells.find( _get_cell_key( cell_x, cell_y ) );
+			if ( itr == _cells.end() ) continue;
+
+			for ( const Entry& entry : itr->second )
+			{
+				const float dx = entry.pos.x - pos.x;
+				const float dy = entry.pos.y - pos.y;
+				if ( dx * dx + dy * dy > radius_sqr ) continue;
+
+				//  Prioritize lowest IDs, as a linear search would do
+				if ( found_point_id == -1 || entry.point_id < found_point_id )
+				{
+					found_point_id = entry.point_id;
+				}
+			}
+		}
+	}
+
+	return found_point_id;
+}
+
+long long ScreenPointGrid::_get_cell_key( int cell_x, int cell_y ) const
+{
+	return ( (long long)cell_x << 32 ) ^ (long long)(unsigned int)cell_y;
+}
+
+int ScreenPointGrid::_get_cell_coordinate( float value ) const
+{
+	return (int)floorf( value / _cell_size );
+}
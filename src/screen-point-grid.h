@@ -0,0 +1,46 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <vector>
+#include <unordered_map>
+
+namespace curve_editor_x
+{
+	/*
+	 * Bucket grid of screen-space points, answering which point is
+	 * under a position by only checking the cells overlapping the
+	 * search radius.
+	 */
+	class ScreenPointGrid
+	{
+	public:
+		/*
+		 * Removes all points and sets the size of the cells, which
+		 * should be at least twice the search radius so that queries
+		 * check at most four cells.
+		 */
+		void clear( float cell_size );
+		void add_point( int point_id, const Vector2& pos );
+
+		/*
+		 * Returns the lowest point ID within the radius of the given
+		 * position, or -1 if none.
+		 */
+		int find_point_at( const Vector2& pos, float radius ) const;
+
+	private:
+		struct Entry
+		{
+			int point_id;
+			Vector2 pos;
+		};
+
+		long long _get_cell_key( int cell_x, int cell_y ) const;
+		int _get_cell_coordinate( float value ) const;
+
+	private:
+		float _cell_size = 1.0f;
+		std::unordered_map<long long, std::vector<Entry>> _cells {};
+	};
+}
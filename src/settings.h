@@ -24,12 +24,43 @@ namespace curve_editor_x
 		constexpr float CURVE_THICKNESS = 2.0f;
 		//  How much to offset the thickness per wheel scroll?
 		constexpr float CURVE_THICKNESS_SENSITIVITY = 0.5f;
-		//  Subdivisions for rendering a curve
-		constexpr float CURVE_RENDER_SUBDIVISIONS = 0.01f;
+		//  In pixels, maximum distance between a rendered curve and
+		//  its polyline
+		constexpr float CURVE_FLATNESS_TOLERANCE = 0.25f;
+		//  Maximum subdivisions of a segment for rendering a curve
+		constexpr int   CURVE_TESSELLATION_MAX_DEPTH = 12;
+		//  Zoom levels per doubling of the scale before re-tessellating
+		constexpr int   CURVE_TESSELLATION_ZOOM_BUCKETS = 2;
+		//  In pixels per curve unit, range of the scale segments are
+		//  tessellated for
+		constexpr float CURVE_TESSELLATION_MIN_SCALE = 1.0f / 1024.0f;
+		constexpr float CURVE_TESSELLATION_MAX_SCALE = 4096.0f;
+		//  In pixels, gap between two samples of a time-evaluated curve
+		constexpr float CURVE_TIME_SAMPLES_GAP = 1.0f;
+		//  Maximum ratio between a joint's miter length and the half 
+		//  thickness before beveling it
+		constexpr float CURVE_MITER_LIMIT = 4.0f;
+		//  Maximum points of a curve's polyline to retain its stroke as
+		//  a mesh, larger ones are culled & stroked every view change
+		constexpr int   CURVE_MESH_MAX_POINTS = 65536;
+		//  Sub-intervals measured per segment for distance-evaluation
+		constexpr int   ARC_LENGTH_SEGMENT_SAMPLES = 8;
+		//  Coarse samples & refinement steps of nearest-point queries
+		constexpr int   NEAREST_SEGMENT_SAMPLES = 8;
+		constexpr int   NEAREST_NEWTON_ITERATIONS = 4;
+		//  Samples of a uniformly baked curve, and probes between two
+		//  samples for measuring its error
+		constexpr int   BAKE_RESOLUTION = 256;
+		constexpr int   BAKE_ERROR_PROBES = 8;
+		//  Maximum error & subdivisions of an adaptively baked curve
+		constexpr float BAKE_MAX_ERROR = 0.001f;
+		constexpr int   BAKE_MAX_DEPTH = 16;
 		constexpr float CURVE_FRAME_PADDING = 32.0f;
 		constexpr float TANGENT_THICKNESS = 2.0f;
 		constexpr float POINT_SIZE = CURVE_THICKNESS * 3.0f;
 		constexpr float POINT_SELECTED_OFFSET_SIZE = 3.0f;
+		//  Triangles of a round point's marker
+		constexpr int   MARKER_CIRCLE_SEGMENTS = 16;
 		constexpr double DOUBLE_CLICK_TIME = 0.2;
 		constexpr float SELECTION_RADIUS = 8.0f;
 
@@ -45,6 +76,8 @@ namespace curve_editor_x
 		constexpr float GRID_LARGE_GRID_FONT_SIZE = 20.0f;
 		constexpr float GRID_FONT_SPACING = 1.0f;
 		constexpr float GRID_TEXT_PADDING = 2.0f;
+		//  Maximum formatted labels kept by the grid
+		constexpr int   GRID_LABELS_CACHE_SIZE = 1024;
 
 		constexpr float FRAME_PADDING = 32.0f;
 
@@ -57,6 +90,34 @@ namespace curve_editor_x
 
 		//  Does the frame rendering clips its content?
 		constexpr bool  ENABLE_CLIPPING = true;
+		//  Are un-selected layers drawn into a texture, only re-drawn 
+		//  when one of them or the view changes?
+		constexpr bool  CACHE_UNSELECTED_LAYERS = true;
+		//  Does the application sleep until an input event and only
+		//  render frames where something changed?
+		constexpr bool  ENABLE_ON_DEMAND_RENDERING = true;
+
+		//  Frames kept by the profiler for its graph & percentiles
+		constexpr int   PROFILER_HISTORY_SIZE = 240;
+		//  In milliseconds, minimum time at the top of the graph
+		constexpr float PROFILER_GRAPH_MAX_TIME = 1000.0f / 30.0f;
+		constexpr float PROFILER_GRAPH_HEIGHT = 60.0f;
+		constexpr float PROFILER_FONT_SIZE = 10.0f;
+		constexpr Color PROFILER_BACKGROUND_COLOR { 0, 0, 0, 200 };
+		constexpr Color PROFILER_TEXT_COLOR { 230, 230, 230, 255 };
+		constexpr Color PROFILER_GRAPH_COLOR { 120, 200, 120, 255 };
+
+		//  Traced scopes kept before overwriting the oldest ones
+		constexpr int   TRACE_EVENTS_CAPACITY = 1 << 16;
+		constexpr const char* TRACE_FILE_PATH = "curve-editor-x-trace.json";
+
+		//  Threads loading imported files, 0 to use the hardware ones
+		constexpr int   IMPORT_THREADS_COUNT = 0;
+		//  Imported layers added per frame, keeping the UI interactive
+		constexpr int   IMPORT_BATCH_SIZE = 16;
+		constexpr float IMPORT_PROGRESS_HEIGHT = 4.0f;
+		constexpr int   IMPORT_PROGRESS_FONT_SIZE = 16;
+		constexpr Color IMPORT_PROGRESS_COLOR { 80, 150, 220, 255 };
 		constexpr bool  DRAW_MOUSE_POSITION = true;
 		//  Does the zoom is clamped between ZOOM_MIN and ZOOM_MAX?
 		constexpr bool  IS_ZOOM_CLAMPED = false;
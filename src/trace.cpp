@@ -0,0 +1,89 @@
+#include "trace.h"
+
+#include <src/settings.h>
+
+#include <fstream>
+
+using namespace curve_editor_x;
+
+constexpr uint64_t EVENTS_CAPACITY = settings::TRACE_EVENTS_CAPACITY;
+
+Tracer::Event Tracer::_events[EVENTS_CAPACITY] {};
+std::atomic<uint64_t> Tracer::_next_event_id { 0 };
+const Tracer::Clock::time_point Tracer::_start_time = Tracer::Clock::now();
+
+void Tracer::add_scope(
+	const char* name,
+	Clock::time_point start_time,
+	Clock::time_point end_time
+)
+{
+	const uint64_t id = _next_event_id.fetch_add( 1, std::memory_order_relaxed );
+	Event& event = _events[id % EVENTS_CAPACITY];
+
+	//  Invalidate the slot while writing it
+	event.sequence.store( 0, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+
+	event.name = name;
+	event.thread_id = _get_thread_id();
+	event.start_time = std::chrono::duration_cast<std::chrono::microseconds>(
+		start_time - _start_time ).count();
+	event.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+		end_time - start_time ).count();
+
+	event.sequence.store( id + 1, std::memory_order_release );
+}
+
+bool Tracer::write_to_file( const std::string& path )
+{
+	std::ofstream file( path );
+	if ( !file.is_open() ) return false;
+
+	//  Oldest events still in the buffer
+	const uint64_t last_id = _next_event_id.load( std::memory_order_acquire );
+	const uint64_t first_id = last_id > EVENTS_CAPACITY
+		? last_id - EVENTS_CAPACITY
+		: 0;
+
+	file << "{\"traceEvents\":[";
+
+	bool is_first = true;
+	for ( uint64_t id = first_id; id < last_id; id++ )
+	{
+		const Event& event = _events[id % EVENTS_CAPACITY];
+		if ( event.sequence.load( std::memory_order_acquire ) != id + 1 ) continue;
+
+		const char* name = event.name;
+		const uint32_t thread_id = event.thread_id;
+		const int64_t start_time = event.start_time;
+		const int64_t duration = event.duration;
+
+		//  Skip the event if overwritten while reading it
+		std::atomic_thread_fence( std::memory_order_acquire );
+		if ( event.sequence.load( std::memory_order_relaxed ) != id + 1 ) continue;
+
+		if ( !is_first ) file << ",";
+		is_first = false;
+
+		//  Names are literals, they don't need to be escaped
+		file << "\n{\"name\":\"" << name << "\""
+			 << ",\"ph\":\"X\",\"pid\":1"
+			 << ",\"tid\":" << thread_id
+			 << ",\"ts\":" << start_time
+			 << ",\"dur\":" << duration << "}";
+	}
+
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	file.close();
+
+	return true;
+}
+
+uint32_t Tracer::_get_thread_id()
+{
+	static std::atomic<uint32_t> next_thread_id { 1 };
+	thread_local uint32_t thread_id = next_thread_id.fetch_add( 1 );
+
+	return thread_id;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/*
+ * Scoped timing markers, recorded only when compiled with
+ * CURVE_EDITOR_X_ENABLE_TRACING (see the CMake option of the same
+ * name), otherwise compiling to nothing.
+ *
+ * The name must be a string literal.
+ */
+#ifdef CURVE_EDITOR_X_ENABLE_TRACING
+	#define CURVE_EDITOR_X_TRACE_CONCAT_IMPL( a, b ) a##b
+	#define CURVE_EDITOR_X_TRACE_CONCAT( a, b ) CURVE_EDITOR_X_TRACE_CONCAT_IMPL( a, b )
+	#define TRACE_SCOPE( name ) \
+		::curve_editor_x::TraceScope \
+			CURVE_EDITOR_X_TRACE_CONCAT( _trace_scope_, __LINE__ )( name )
+#else
+	#define TRACE_SCOPE( name )
+#endif
+
+namespace curve_editor_x
+{
+	/*
+	 * Fixed-size ring buffer of traced scopes, written by any thread
+	 * without locking and dumpable as a Chrome trace-event JSON, to
+	 * open in 'chrome://tracing' or Perfetto.
+	 *
+	 * When full, the oldest scopes are overwritten.
+	 */
+	class Tracer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static void add_scope(
+			const char* name,
+			Clock::time_point start_time,
+			Clock::time_point end_time
+		);
+
+		/*
+		 * Writes the recorded scopes into a JSON file, returning
+		 * false if the file isn't writtable.
+		 */
+		static bool write_to_file( const std::string& path );
+
+	private:
+		struct Event
+		{
+			//  Index of the event plus one, written last so that
+			//  readers can skip events being (over-)written
+			std::atomic<uint64_t> sequence { 0 };
+
+			const char* name = nullptr;
+			uint32_t thread_id = 0;
+			int64_t start_time = 0;
+			int64_t duration = 0;
+		};
+
+		static uint32_t _get_thread_id();
+
+	private:
+		static Event _events[];
+		static std::atomic<uint64_t> _next_event_id;
+		static const Clock::time_point _start_time;
+	};
+
+	/*
+	 * Records its lifetime into the tracer, use TRACE_SCOPE instead.
+	 */
+	class TraceScope
+	{
+	public:
+		TraceScope( const char* name )
+			: _name( name ), _start_time( Tracer::Clock::now() ) {}
+		~TraceScope()
+		{
+			Tracer::add_scope( _name, _start_time, Tracer::Clock::now() );
+		}
+
+	private:
+		const char* _name = nullptr;
+		Tracer::Clock::time_point _start_time {};
+	};
+}
@@ -42,6 +42,23 @@ std::string Utils::get_filename_from_path( const std::string& path )
 	return path.substr( path.find_last_of( "/\\" ) + 1 );
 }
 
+std::string Utils::replace_extension(
+	const std::string& path,
+	const std::string& extension
+)
+{
+	//  Ignore dots from directories
+	const size_t extension_pos = path.find_last_of( '.' );
+	const size_t separator_pos = path.find_last_of( "/\\" );
+	if ( extension_pos == std::string::npos
+	  || ( separator_pos != std::string::npos && extension_pos < separator_pos ) )
+	{
+		return path + "." + extension;
+	}
+
+	return path.substr( 0, extension_pos + 1 ) + extension;
+}
+
 std::string LPWSTR_to_str( LPWSTR str )
 {
 	std::wstring path( str );
@@ -17,6 +17,14 @@ namespace curve_editor_x
 		static float approach( float value, float target, float delta );
 
 		static std::string get_filename_from_path( const std::string& path );
+		/*
+		 * Returns the path with its file extension replaced, or added
+		 * if it has none.
+		 */
+		static std::string replace_extension(
+			const std::string& path,
+			const std::string& extension
+		);
 
 		/*
 		 * Open a dialog asking the user to open a file.
@@ -3,6 +3,7 @@
 #include <src/application.h>
 #include <src/utils.h>
 #include <src/settings.h>
+#include <src/trace.h>
 
 using namespace curve_editor_x;
 
@@ -66,7 +67,7 @@ bool CurveEditorWidget::consume_input( const UserInput& input )
 
 		//  Apply the new tangent constraint
 		curve.set_tangent_mode( key_id, next_tangent_mode );
-		curve_ref->has_unsaved_changes = true;
+		curve_ref->mark_dirty();
 
 		return true;
 	}
@@ -124,7 +125,7 @@ bool CurveEditorWidget::consume_input( const UserInput& input )
 		{
 			int key_id = curve.point_to_key_id( _selected_point_id );
 			curve.remove_key( key_id );
-			curve_ref->has_unsaved_changes = true;
+			curve_ref->mark_dirty();
 		}
 
 		return true;
@@ -148,6 +149,8 @@ void CurveEditorWidget::on_focus_changed( bool is_focused )
 
 void CurveEditorWidget::update( float dt )
 {
+	TRACE_SCOPE( "CurveEditorWidget::update" );
+
 	if ( !_application->is_valid_curve_id( _application->get_selected_curve_id() ) ) return;
 
 	auto curve_ref = _application->get_selected_curve_layer();
@@ -162,7 +165,14 @@ void CurveEditorWidget::update( float dt )
 	bool is_hovered = CheckCollisionPointRec( 
 		mouse_pos, frame );
 
+	//  Redraw for hovering, dragging & moving the viewport
+	if ( mouse_delta.x != 0.0f || mouse_delta.y != 0.0f )
+	{
+		mark_dirty();
+	}
+
 	//  LCTRL-down: Grid snapping
+	const bool was_grid_snapping = _is_grid_snapping;
 	_is_grid_snapping = IsKeyDown( KEY_LEFT_CONTROL );
 	if ( _is_grid_snapping )
 	{
@@ -178,12 +188,21 @@ void CurveEditorWidget::update( float dt )
 	}
 
 	//  LSHIFT-down: Quick curve evaluation
+	const bool was_quick_evaluating = _is_quick_evaluating;
 	_is_quick_evaluating = IsKeyDown( KEY_LEFT_SHIFT );
+
+	if ( _is_grid_snapping != was_grid_snapping
+	  || _is_quick_evaluating != was_quick_evaluating )
+	{
+		mark_dirty();
+	}
 	
-	if ( _is_moving_viewport )
+	if ( _is_moving_viewport 
+	  && ( mouse_delta.x != 0.0f || mouse_delta.y != 0.0f ) )
 	{
 		_viewport.x += mouse_delta.x;
 		_viewport.y += mouse_delta.y;
+		_view_revision++;
 	}
 
 	//  WHEEL
@@ -191,6 +210,8 @@ void CurveEditorWidget::update( float dt )
 	{
 		if ( is_hovered )
 		{
+			mark_dirty();
+
 			//  WHEEL + ALT-down: control curve thickness
 			if ( is_alt_down )
 			{
@@ -237,32 +258,17 @@ void CurveEditorWidget::update( float dt )
 					_viewport.x += offset.x - offset.x * zoom_ratio;
 					_viewport.y += offset.y - offset.y * zoom_ratio;
 				}
+				_view_revision++;
 			}
 		}
 	}
 
 	//  Find the mouse hovered point
-	_hovered_point_id = -1;
-	int points_count = curve.get_points_count();
-	for ( int i = 0; i < points_count; i++ )
-	{
-		//  Ignore first left tangent and last right tangent
-		if ( i == 2 || i == points_count - 2 ) continue;
-
-		const Point& point = curve.get_point( i, PointSpace::Global );
-		const Vector2 screen_point = _transform_curve_to_screen( 
-			point );
-
-		if ( CheckCollisionPointCircle( 
-			mouse_pos,
-			screen_point, 
-			settings::SELECTION_RADIUS
-		) )
-		{
-			_hovered_point_id = i;
-			break;
-		}
-	}
+	_update_hover_grid( curve_ref );
+	_hovered_point_id = _hover_grid.find_point_at( 
+		mouse_pos, 
+		settings::SELECTION_RADIUS 
+	);
 
 	//  Move selected point
 	if ( _is_dragging_point && is_valid_selected_point )
@@ -289,11 +295,9 @@ void CurveEditorWidget::update( float dt )
 			);
 		}
 
-		curve_ref->has_unsaved_changes = true;
-	}
-	if ( curve.is_length_dirty ) 
-	{
-		curve.compute_length();
+		//  Only the segments around the moved key need an update
+		curve_ref->mark_key_dirty( 
+			curve.point_to_key_id( _selected_point_id ) );
 	}
 
 	//  Quick curve evaluation
@@ -301,35 +305,37 @@ void CurveEditorWidget::update( float dt )
 	{
 		Point new_point = _transform_screen_to_curve( 
 			_transformed_mouse_pos );
+
+		//  Find nearest point on curve, pruned by the segments tree
+		CurveNearestPoint nearest {};
+		const bool has_nearest = curve_ref->get_segment_tree()
+			.find_nearest_point_to( new_point, &nearest );
 		
 		//  Evaluate at mouse position
 		switch ( _curve_interpolate_mode )
 		{
 			case CurveInterpolateMode::Bezier:
 			case CurveInterpolateMode::DistanceEvaluation:
-				_quick_evaluation_pos = curve.get_nearest_point_to(
-					new_point
-				);
+				if ( has_nearest )
+				{
+					_quick_evaluation_pos = nearest.point;
+				}
 				break;
 
 			case CurveInterpolateMode::TimeEvaluation:
 				_quick_evaluation_pos.x = new_point.x;
-				_quick_evaluation_pos.y = curve.evaluate_by_time( 
-					new_point.x );
+				_quick_evaluation_pos.y = curve_ref->get_time_evaluator()
+					.evaluate_by_time( new_point.x );
 				break;
 		}
 
-		float dist = curve.get_nearest_distance_to( 
-			_transform_screen_to_curve( 
-				_transformed_mouse_pos 
-			) 
-		);
-
-		int first_key_id, last_key_id;
-		curve.find_evaluation_keys_id_by_distance( 
-			&first_key_id, &last_key_id, dist );
+		if ( has_nearest )
+		{
+			int first_key_id = nearest.segment_id;
+			int last_key_id = nearest.segment_id + 1;
 
-		printf( "%d:%d\n", first_key_id, last_key_id );
+			printf( "%d:%d\n", first_key_id, last_key_id );
+		}
 	}
 }
 
@@ -340,6 +346,13 @@ void CurveEditorWidget::render()
 	//  Draw viewport frame
 	DrawRectangleLinesEx( _viewport_frame, 2.0f, GRAY );
 
+	//  Draw un-selected layers off-screen, outside of clipping
+	if ( settings::CACHE_UNSELECTED_LAYERS
+	  && _application->is_valid_selected_curve() )
+	{
+		_update_layers_texture();
+	}
+
 	//  Enable clipping
 	if ( settings::ENABLE_CLIPPING )
 	{
@@ -387,6 +400,7 @@ void CurveEditorWidget::invalidate_layout()
 	_viewport.y = _viewport_frame.y + settings::CURVE_FRAME_PADDING + ui_height;
 	_viewport.width = _viewport_frame.width - settings::CURVE_FRAME_PADDING * 2.0f;
 	_viewport.height = _viewport_frame.height - settings::CURVE_FRAME_PADDING * 2.0f - ui_height;
+	_view_revision++;
 
 	_invalidate_grid();
 }
@@ -397,9 +411,10 @@ void CurveEditorWidget::fit_viewport()
 	auto layers = _application->get_curve_layers();
 	for ( const auto& layer : layers )
 	{
-		if ( layer->curve.is_valid() )
+		//  Packed layers are fitted without being decoded
+		if ( !layer->is_loaded() || layer->curve.is_valid() )
 		{
-			auto extrems = layer->curve.get_extrems();
+			auto extrems = layer->get_extrems();
 			_curve_extrems.min_x = 
 				std::min( _curve_extrems.min_x, extrems.min_x );
 			_curve_extrems.max_x = 
@@ -415,6 +430,23 @@ void CurveEditorWidget::fit_viewport()
 	invalidate_layout();
 }
 
+bool CurveEditorWidget::_is_extrems_visible( const CurveExtrems& extrems ) const
+{
+	const Vector2 a = _transform_curve_to_screen( 
+		Point { extrems.min_x, extrems.min_y } );
+	const Vector2 b = _transform_curve_to_screen( 
+		Point { extrems.max_x, extrems.max_y } );
+
+	//  Include the stroke's thickness
+	const Rectangle bounds {
+		std::min( a.x, b.x ) - _curve_thickness,
+		std::min( a.y, b.y ) - _curve_thickness,
+		fabsf( b.x - a.x ) + _curve_thickness * 2.0f,
+		fabsf( b.y - a.y ) + _curve_thickness * 2.0f,
+	};
+	return CheckCollisionRecs( bounds, _viewport_frame );
+}
+
 void CurveEditorWidget::_invalidate_grid()
 {
 	//  Determine visible range in curve units
@@ -422,65 +454,7 @@ void CurveEditorWidget::_invalidate_grid()
 		{ frame.x, 0.0f } );
 	const Vector2& right_pos = _transform_screen_to_curve(
 		{ frame.x + frame.width, 0.0f } );
-	const float visible_range = right_pos.x - left_pos.x;
-
-	/*printf( "inputs: visible_range=%f; zoom=%f\n", 
-		visible_range, _zoom );*/
-
-	//  Subdivide visible range
-	_grid_gap = visible_range / ( settings::GRID_LARGE_COUNT * settings::GRID_SMALL_GAP );
-
-	//  Get level power depending on zoom range
-	float level_power = 0.0f;
-	if ( _grid_gap >= 1.0f )
-	{
-		std::string str_grid_gap = std::to_string( (int)floorf( _grid_gap ) );
-		//printf( "%s\n", str_grid_gap.c_str() );
-
-		level_power = (float)( str_grid_gap.length() - 1 );
-
-		//  Update label format
-		_grid_label_format = "%.0f";
-	}
-	else
-	{
-		std::string str_grid_gap = std::to_string( _grid_gap );
-		//printf( "%s\n", str_grid_gap.c_str() );
-
-		//  Count number of zeros until first digit
-		int zero_count = 0;
-		for ( char letter : str_grid_gap )
-		{
-			if ( letter == '.' ) continue;
-			if ( letter != '0' ) break;
-
-			zero_count++;
-		}
-
-		level_power = (float)( -zero_count );
-		
-		//  Update label format
-		_grid_label_format = "%.0" + std::to_string( zero_count ) + "f";
-	}
-
-	//  Snap grid gap to closest level
-	float closest_dist = visible_range;
-	float closest_level = 0; 
-	for ( float level : settings::GRID_LEVELS )
-	{
-		float exponent = powf( 10.0f, level_power );
-		level *= exponent;
-
-		float dist = fabsf( _grid_gap - level );
-		if ( dist < closest_dist )
-		{
-			closest_level = level;
-			closest_dist = dist;
-		}
-	}
-	_grid_gap = closest_level;
-
-	//printf( "output: grid_gap=%f\n", _grid_gap );
+	_grid.set_visible_range( right_pos.x - left_pos.x );
 }
 
 bool CurveEditorWidget::_is_double_clicking( bool should_consume )
@@ -510,15 +484,14 @@ void CurveEditorWidget::_add_key_at_position( bool is_alt_down )
 	//  ALT-down: insert key
 	if ( is_alt_down )
 	{
-		//  TODO: fix this feature and Curve::compute_length
-		//  Find distance on curve from point
-		float dist = curve.get_nearest_distance_to( 
-			key.control );
+		//  Find nearest point on curve
+		CurveNearestPoint nearest {};
+		if ( !layer->get_segment_tree().find_nearest_point_to( 
+			key.control, &nearest ) ) return;
 
-		//  Find the key index to insert from
-		int first_key_id, last_key_id;
-		curve.find_evaluation_keys_id_by_distance( 
-			&first_key_id, &last_key_id, dist );
+		//  Insert between the keys of the nearest segment
+		int first_key_id = nearest.segment_id;
+		int last_key_id = nearest.segment_id + 1;
 
 		//printf( "=> %d:%d\n", first_key_id, last_key_id );
 
@@ -535,7 +508,59 @@ void CurveEditorWidget::_add_key_at_position( bool is_alt_down )
 			curve.get_keys_count() - 1 );
 	}
 
-	layer->has_unsaved_changes = true;
+	layer->mark_dirty();
+}
+
+void CurveEditorWidget::_update_hover_grid( const ref<CurveLayer>& layer )
+{
+	//  Only rebuild when the curve or the viewport changed
+	if ( _hover_grid_layer.lock() == layer 
+	  && _hover_grid_layer_revision == layer->revision
+	  && _hover_grid_view_revision == _view_revision ) return;
+
+	_hover_grid_layer = layer;
+	_hover_grid_layer_revision = layer->revision;
+	_hover_grid_view_revision = _view_revision;
+
+	const Curve& curve = layer->curve;
+	_hover_grid.clear( settings::SELECTION_RADIUS * 2.0f );
+
+	//  Only the points of visible keys can be hovered
+	layer->get_segment_tree().find_segments_in(
+		_get_visible_curve_extrems( settings::SELECTION_RADIUS ),
+		&_visible_segment_ids
+	);
+
+	int points_count = curve.get_points_count();
+	auto add_key_points = [&]( int key_id ) {
+		const int control_point_id = curve.key_to_point_id( key_id );
+		for ( int i = control_point_id; i < control_point_id + 3; i++ )
+		{
+			//  Ignore first left tangent and last right tangent
+			if ( i == 2 || i == points_count - 2 ) continue;
+
+			const Point& point = curve.get_point( i, PointSpace::Global );
+			_hover_grid.add_point( i, _transform_curve_to_screen( point ) );
+		}
+	};
+
+	int last_key_id = -1;
+	for ( int segment_id : _visible_segment_ids )
+	{
+		for ( int key_id = std::max( segment_id, last_key_id + 1 ); 
+			  key_id <= segment_id + 1; 
+			  key_id++ )
+		{
+			add_key_points( key_id );
+		}
+		last_key_id = segment_id + 1;
+	}
+
+	//  A single key doesn't form any segment
+	if ( curve.get_keys_count() == 1 )
+	{
+		add_key_points( 0 );
+	}
 }
 
 float CurveEditorWidget::_transform_curve_to_screen_x( float x ) const
@@ -581,23 +606,45 @@ Vector2 CurveEditorWidget::_transform_screen_to_curve(
 	);
 }
 
-Vector2 CurveEditorWidget::_transform_rounded_grid_snap( 
-	const Vector2& pos 
-) const
+Point CurveEditorWidget::_get_curve_to_screen_scale() const
 {
-	return Vector2 {
-		roundf( pos.x / _grid_gap ) * _grid_gap,
-		roundf( pos.y / _grid_gap ) * _grid_gap,
+	return Point {
+		fabsf( _viewport.width * _zoom 
+			/ ( _curve_extrems.max_x - _curve_extrems.min_x ) ),
+		fabsf( _viewport.height * _zoom 
+			/ ( _curve_extrems.max_y - _curve_extrems.min_y ) ),
 	};
 }
 
-Vector2 CurveEditorWidget::_transform_ceiled_grid_snap( 
+CurveExtrems CurveEditorWidget::_get_visible_curve_extrems( 
+	float padding 
+) const
+{
+	const Vector2 top_left = _transform_screen_to_curve( { 
+		_viewport_frame.x - padding, 
+		_viewport_frame.y - padding
+	} );
+	const Vector2 bottom_right = _transform_screen_to_curve( { 
+		_viewport_frame.x + _viewport_frame.width + padding, 
+		_viewport_frame.y + _viewport_frame.height + padding
+	} );
+
+	CurveExtrems extrems {};
+	extrems.min_x = std::min( top_left.x, bottom_right.x );
+	extrems.max_x = std::max( top_left.x, bottom_right.x );
+	extrems.min_y = std::min( top_left.y, bottom_right.y );
+	extrems.max_y = std::max( top_left.y, bottom_right.y );
+	return extrems;
+}
+
+Vector2 CurveEditorWidget::_transform_rounded_grid_snap( 
 	const Vector2& pos 
 ) const
 {
+	const float gap = _grid.get_gap();
 	return Vector2 {
-		ceilf( pos.x / _grid_gap ) * _grid_gap,
-		ceilf( pos.y / _grid_gap ) * _grid_gap,
+		roundf( pos.x / gap ) * gap,
+		roundf( pos.y / gap ) * gap,
 	};
 }
 
@@ -662,20 +709,18 @@ void CurveEditorWidget::_render_curve_screen()
 	}
 
 	//  Draw curve layers
-	auto layers = _application->get_curve_layers();
-	for ( const auto& layer : layers )
+	if ( settings::CACHE_UNSELECTED_LAYERS )
 	{
-		switch ( _curve_interpolate_mode )
+		//  Selected layer is drawn on top of the others
+		_layers_texture.render();
+		_render_curve_layer( selected_layer );
+	}
+	else
+	{
+		auto layers = _application->get_curve_layers();
+		for ( const auto& layer : layers )
 		{
-			case CurveInterpolateMode::Bezier:
-				_render_curve_by_bezier( layer );
-				break;
-			case CurveInterpolateMode::TimeEvaluation:
-				_render_curve_by_time( layer );
-				break;
-			case CurveInterpolateMode::DistanceEvaluation:
-				_render_curve_by_distance( layer );
-				break;
+			_render_curve_layer( layer );
 		}
 	}
 
@@ -803,56 +848,68 @@ void CurveEditorWidget::_render_invalid_curve_screen()
 	}
 }
 
-void CurveEditorWidget::_render_curve_by_distance( 
-	const ref<CurveLayer>& layer 
-)
+void CurveEditorWidget::_update_layers_texture()
 {
-	//  Draw curve's length
-	const float length = layer->curve.get_length();
-	/*DrawText(
-		TextFormat( "length: %.3f", length ),
-		(int) ( _viewport_frame.x + 25 + CURVE_FRAME_PADDING * 0.5f ),
-		(int) ( _viewport_frame.y + 25 + CURVE_FRAME_PADDING * 0.5f ),
-		20,
-		TEXT_COLOR
-	);*/
+	TRACE_SCOPE( "CurveEditorWidget::_update_layers_texture" );
 
-	const Color color {
-		layer->color.r,
-		layer->color.g,
-		layer->color.b,
-		layer->is_selected 
-			? settings::CURVE_SELECTED_OPACITY 
-			: settings::CURVE_UNSELECTED_OPACITY
+	const Rectangle texture_frame {
+		floorf( _viewport_frame.x ),
+		floorf( _viewport_frame.y ),
+		ceilf( _viewport_frame.width ),
+		ceilf( _viewport_frame.height ),
 	};
+	if ( texture_frame.width < 1.0f || texture_frame.height < 1.0f ) return;
 
-	Vector2 previous_pos = _transform_curve_to_screen(
-		layer->curve.evaluate_by_distance( 0.0f ) );
+	auto layers = _application->get_curve_layers();
 
-	//  Draw curve using distance-evaluation
-	const float step = length * settings::CURVE_RENDER_SUBDIVISIONS;
-	for ( float dist = step; dist < length; dist += step )
+	//  Find what the texture would contain
+	_layer_signatures.clear();
+	for ( const auto& layer : layers )
 	{
-		const Vector2 pos = _transform_curve_to_screen(
-			layer->curve.evaluate_by_distance( dist ) );
+		if ( layer->is_selected ) continue;
 
-		//  Draw line
-		DrawLineEx(
-			previous_pos,
-			pos,
-			_curve_thickness,
-			color
-		);
+		_layer_signatures.push_back( CurveLayerSignature {
+			layer.get(),
+			layer->revision,
+			layer->color,
+		} );
+	}
 
-		previous_pos = pos;
+	if ( !_layers_texture.is_dirty( 
+		_layer_signatures, 
+		_view_revision, 
+		_curve_interpolate_mode, 
+		_curve_thickness, 
+		texture_frame ) ) return;
+
+	_layers_texture.begin(
+		_layer_signatures, 
+		_view_revision, 
+		_curve_interpolate_mode, 
+		_curve_thickness, 
+		texture_frame
+	);
+	for ( const auto& layer : layers )
+	{
+		if ( layer->is_selected ) continue;
+
+		_render_curve_layer( layer );
 	}
+	_layers_texture.end();
 }
 
-void CurveEditorWidget::_render_curve_by_time( 
+void CurveEditorWidget::_render_curve_layer( 
 	const ref<CurveLayer>& layer 
 )
 {
-	const int points_count = layer->curve.get_points_count();
+	//  Packed layers are only decoded once visible
+	if ( !layer->is_loaded() )
+	{
+		if ( !_is_extrems_visible( layer->get_extrems() ) ) return;
+		//  Decoded once its pack is saved
+		if ( _application->is_saving_pack( layer->pack ) ) return;
+		layer->load();
+	}
 
 	const Color color {
 		layer->color.r,
@@ -863,133 +920,335 @@ void CurveEditorWidget::_render_curve_by_time(
 			: settings::CURVE_UNSELECTED_OPACITY
 	};
 
-	//  Determine bounds and steps
-	const float min_x = layer->curve.get_point( 0 ).x;
-	const float max_x = layer->curve.get_point( points_count - 3 ).x;
-	const float step = ( max_x - min_x ) * settings::CURVE_RENDER_SUBDIVISIONS;
+	//  Un-selected layers are rarely edited, their mesh is kept and
+	//  only translated when panning
+	if ( !layer->is_selected 
+	  && _curve_interpolate_mode != CurveInterpolateMode::TimeEvaluation
+	  && _render_curve_layer_mesh( layer, color ) ) return;
+
+	//  Rebuild the stroke only if the curve or the view changed, 
+	//  otherwise its triangles are re-submitted as-is
+	CurveStrokeCache& cache = layer->stroke_cache;
+	if ( cache.revision != layer->revision
+	  || cache.view_revision != _view_revision
+	  || cache.mode != _curve_interpolate_mode
+	  || cache.thickness != _curve_thickness )
+	{
+		cache.stroke.clear();
+		cache.revision = layer->revision;
+		cache.view_revision = _view_revision;
+		cache.mode = _curve_interpolate_mode;
+		cache.thickness = _curve_thickness;
+
+		//  Time-evaluation only samples the visible interval
+		if ( _curve_interpolate_mode == CurveInterpolateMode::TimeEvaluation )
+		{
+			_build_curve_stroke_by_time( layer, &cache.stroke );
+		}
+		else
+		{
+			_build_curve_stroke( layer, &cache.stroke );
+		}
+	}
+
+	//  Draw all lines at once
+	cache.stroke.render( color );
+}
 
-	Vector2 previous_pos = _transform_curve_to_screen(
-		layer->curve.evaluate_by_percent( 0.0f ) );
+bool CurveEditorWidget::_render_curve_layer_mesh(
+	const ref<CurveLayer>& layer,
+	const Color& color
+)
+{
+	TRACE_SCOPE( "CurveEditorWidget::_render_curve_layer_mesh" );
 
-	//  Draw curve using time-evaluation
-	for ( float x = min_x; x < max_x + step; x += step )
+	CurveStrokeMesh& mesh = layer->stroke_cache.mesh;
+	const Point scale = _get_curve_to_screen_scale();
+	const Vector2 origin = _transform_curve_to_screen( Point { 0.0f, 0.0f } );
+
+	if ( mesh.is_dirty( 
+		layer->revision, _curve_interpolate_mode, scale, _curve_thickness ) )
 	{
-		const Vector2 pos = _transform_curve_to_screen(
-			Point {
-				x,
-				layer->curve.evaluate_by_time( x ),
+		CurveTessellation& tessellation = layer->get_tessellation( scale );
+		const int segments_count = tessellation.get_segments_count();
+
+		//  Too large to be entirely stroked, fallback to culling
+		if ( segments_count + 1 > settings::CURVE_MESH_MAX_POINTS )
+		{
+			mesh.unload();
+			return false;
+		}
+
+		//  Project relatively to the curve's origin with the scale of
+		//  the zoom bucket, consecutive segments sharing their ends
+		const Point mesh_scale = CurveStrokeMesh::get_mesh_scale( scale );
+		_screen_points.clear();
+		for ( int i = 0; i < segments_count; i++ )
+		{
+			const std::vector<Point>& points = 
+				tessellation.get_segment_points( layer->curve, i );
+			for ( size_t j = i == 0 ? 0 : 1; j < points.size(); j++ )
+			{
+				//  Screen's Y-axis is pointing down
+				_screen_points.push_back( Vector2 { 
+					points[j].x * mesh_scale.x, 
+					-points[j].y * mesh_scale.y 
+				} );
 			}
-		);
 
-		//  Draw line
-		DrawLineEx(
-			previous_pos,
-			pos,
+			//  Stop tessellating once too large as well
+			if ( (int)_screen_points.size() > settings::CURVE_MESH_MAX_POINTS )
+			{
+				mesh.unload();
+				return false;
+			}
+		}
+
+		_mesh_stroke.clear();
+		_mesh_stroke.add_polyline(
+			_screen_points.data(),
+			(int)_screen_points.size(),
 			_curve_thickness,
-			color
+			settings::CURVE_MITER_LIMIT
+		);
+		mesh.upload( 
+			_mesh_stroke.get_vertices(),
+			layer->revision, 
+			_curve_interpolate_mode, 
+			scale, 
+			_curve_thickness
 		);
-
-		previous_pos = pos;
 	}
+
+	mesh.render( origin, scale, color );
+	return true;
 }
 
-void CurveEditorWidget::_render_curve_by_bezier( 
-	const ref<CurveLayer>& layer 
+void CurveEditorWidget::_build_curve_stroke(
+	const ref<CurveLayer>& layer,
+	PolylineStroke* stroke
 )
 {
-	int keys_count = layer->curve.get_keys_count();
+	TRACE_SCOPE( "CurveEditorWidget::_build_curve_stroke" );
 
-	const Color color {
-		layer->color.r,
-		layer->color.g,
-		layer->color.b,
-		layer->is_selected 
-			? settings::CURVE_SELECTED_OPACITY 
-			: settings::CURVE_UNSELECTED_OPACITY
-	};
+	//  Cull segments outside of the viewport first, so only visible 
+	//  ones are tessellated
+	layer->get_segment_tree().find_segments_in(
+		_get_visible_curve_extrems( _curve_thickness ),
+		&_visible_segment_ids
+	);
+
+	//  Retrieve cached curve-space polylines, only re-tessellated on
+	//  edits and large zoom changes
+	CurveTessellation& tessellation = layer->get_tessellation( 
+		_get_curve_to_screen_scale() );
+
+	//  Stroke the polylines of the visible segments, joining 
+	//  consecutive segments into a single polyline
+	_screen_points.clear();
+	int last_segment_id = -1;
+	for ( int segment_id : _visible_segment_ids )
+	{
+		if ( segment_id != last_segment_id + 1 )
+		{
+			_add_screen_polyline_to_stroke( stroke );
+		}
+
+		//  Consecutive segments share their ends
+		const std::vector<Point>& points = 
+			tessellation.get_segment_points( layer->curve, segment_id );
+		for ( size_t i = _screen_points.empty() ? 0 : 1; i < points.size(); i++ )
+		{
+			_screen_points.push_back( _transform_curve_to_screen( points[i] ) );
+		}
 
-	for ( int i = 0; i < keys_count - 1; i++ )
-	{
-		//  Get keys
-		const CurveKey current_key = layer->curve.get_key( i );
-		const CurveKey next_key = layer->curve.get_key( i + 1 );
-
-		//  Get points
-		const Point p0 = current_key.control;
-		const Point t0 = current_key.right_tangent;
-		const Point t1 = next_key.left_tangent;
-		const Point p1 = next_key.control;
-
-		//  Translate them from curve-space to screen-space
-		const Vector2 pos0 = _transform_curve_to_screen( p0 );
-		const Vector2 pos1 = _transform_curve_to_screen( p0 + t0 );
-		const Vector2 pos2 = _transform_curve_to_screen( p1 + t1 );
-		const Vector2 pos3 = _transform_curve_to_screen( p1 );
-
-		//  Draw curve
-		DrawSplineSegmentBezierCubic(
-			pos0,
-			pos1,
-			pos2,
-			pos3,
+		last_segment_id = segment_id;
+	}
+	_add_screen_polyline_to_stroke( stroke );
+}
+
+void CurveEditorWidget::_build_curve_stroke_by_time(
+	const ref<CurveLayer>& layer,
+	PolylineStroke* stroke
+)
+{
+	TRACE_SCOPE( "CurveEditorWidget::_build_curve_stroke_by_time" );
+
+	const Curve& curve = layer->curve;
+	if ( curve.get_keys_count() == 0 ) return;
+
+	//  Clamp the visible interval to the curve's keys
+	const CurveExtrems visible_extrems = 
+		_get_visible_curve_extrems( _curve_thickness );
+	const float min_time = std::max( 
+		visible_extrems.min_x, curve.get_key( 0 ).control.x );
+	const float max_time = std::min( 
+		visible_extrems.max_x, 
+		curve.get_key( curve.get_keys_count() - 1 ).control.x );
+	if ( max_time < min_time ) return;
+
+	//  Spread samples on the covered pixels
+	const float pixels = ( max_time - min_time ) 
+		* _get_curve_to_screen_scale().x;
+	const int samples_count = 
+		(int)ceilf( pixels / settings::CURVE_TIME_SAMPLES_GAP ) + 1;
+
+	const std::vector<Point>& points = 
+		layer->get_time_samples( min_time, max_time, samples_count );
+
+	//  Project the polyline through the viewport transform
+	_screen_points.clear();
+	for ( const Point& point : points )
+	{
+		_screen_points.push_back( _transform_curve_to_screen( point ) );
+	}
+	_add_screen_polyline_to_stroke( stroke );
+}
+
+void CurveEditorWidget::_add_screen_polyline_to_stroke( PolylineStroke* stroke )
+{
+	if ( _screen_points.size() >= 2 )
+	{
+		stroke->add_polyline(
+			_screen_points.data(),
+			(int)_screen_points.size(),
 			_curve_thickness,
-			color
+			settings::CURVE_MITER_LIMIT
 		);
 	}
+
+	_screen_points.clear();
 }
 
 void CurveEditorWidget::_render_curve_points( 
 	const ref<CurveLayer>& layer 
 )
 {
-	int keys_count = layer->curve.get_keys_count();
+	TRACE_SCOPE( "CurveEditorWidget::_render_curve_points" );
 
-	for ( int key_id = 0; key_id < keys_count; key_id++ )
-	{
-		int control_point_id = layer->curve.key_to_point_id( key_id );
+	const CurveKeyMarkers& markers = layer->get_key_markers();
+	const int keys_count = markers.get_markers_count();
 
-		//  Get control point
-		const CurveKey& key = layer->curve.get_key( key_id );
-		const Vector2& control_pos =
-			_transform_curve_to_screen( key.control );
+	//  Cull segments outside of the viewport, including points 
+	//  overlapping its borders
+	layer->get_segment_tree().find_segments_in(
+		_get_visible_curve_extrems( 
+			settings::POINT_SIZE + settings::POINT_SELECTED_OFFSET_SIZE ),
+		&_visible_segment_ids
+	);
 
-		//  Draw left tangent
-		if ( key_id > 0 )
+	//  Tangents lie inside the hull of their segment, so the visible
+	//  keys are the ends of the visible segments
+	_visible_key_ids.clear();
+	for ( int segment_id : _visible_segment_ids )
+	{
+		const int first_key_id = _visible_key_ids.empty()
+			? segment_id
+			: std::max( segment_id, _visible_key_ids.back() + 1 );
+		for ( int key_id = first_key_id; key_id <= segment_id + 1; key_id++ )
 		{
-			const Vector2& tangent_pos = _transform_curve_to_screen(
-				key.control + key.left_tangent );
-
-			DrawLineEx(
-				control_pos,
-				tangent_pos,
-				settings::TANGENT_THICKNESS,
-				settings::TANGENT_COLOR
-			);
-
-			_render_point( control_point_id + 2, tangent_pos );
+			_visible_key_ids.push_back( key_id );
 		}
+	}
 
-		//  Draw right tangent
-		if ( key_id < keys_count - 1 )
-		{
-			const Vector2& tangent_pos = _transform_curve_to_screen(
-				key.control + key.right_tangent
-			);
+	//  A single key doesn't form any segment
+	if ( keys_count == 1 )
+	{
+		_visible_key_ids.push_back( 0 );
+	}
 
-			DrawLineEx(
-				control_pos,
-				tangent_pos,
-				settings::TANGENT_THICKNESS,
-				settings::TANGENT_COLOR
-			);
+	//  Build markers of all visible keys, tangent lines first so that
+	//  they are under all points
+	_marker_batch.clear();
+	for ( int key_id : _visible_key_ids )
+	{
+		_add_curve_key_tangent_lines( markers, key_id );
+	}
+	for ( int key_id : _visible_key_ids )
+	{
+		_add_curve_key_points( layer->curve, markers, key_id );
+	}
 
-			_render_point( control_point_id + 1, tangent_pos );
-		}
+	//  Draw them at once
+	_marker_batch.render();
+
+	//  Draw texts of the selected point
+	if ( layer->curve.is_valid_point_id( _selected_point_id ) )
+	{
+		_render_selected_point_texts( layer->curve, markers );
+	}
+}
+
+void CurveEditorWidget::_add_curve_key_tangent_lines( 
+	const CurveKeyMarkers& markers,
+	int key_id
+)
+{
+	const CurveKeyMarker& marker = markers.get_marker( key_id );
+	const Vector2 control_pos = _transform_curve_to_screen( marker.control );
+
+	//  Left tangent
+	if ( key_id > 0 )
+	{
+		_marker_batch.add_line(
+			control_pos,
+			_transform_curve_to_screen( marker.left_tangent ),
+			settings::TANGENT_THICKNESS,
+			settings::TANGENT_COLOR
+		);
+	}
 
-		_render_point( control_point_id, control_pos );
+	//  Right tangent
+	if ( key_id < markers.get_markers_count() - 1 )
+	{
+		_marker_batch.add_line(
+			control_pos,
+			_transform_curve_to_screen( marker.right_tangent ),
+			settings::TANGENT_THICKNESS,
+			settings::TANGENT_COLOR
+		);
 	}
 }
 
+void CurveEditorWidget::_add_curve_key_points( 
+	const Curve& curve,
+	const CurveKeyMarkers& markers,
+	int key_id
+)
+{
+	const CurveKeyMarker& marker = markers.get_marker( key_id );
+	const int control_point_id = curve.key_to_point_id( key_id );
+
+	//  Left tangent
+	if ( key_id > 0 )
+	{
+		_add_point_marker(
+			control_point_id + 2,
+			_transform_curve_to_screen( marker.left_tangent ),
+			true,
+			marker.tangent_mode
+		);
+	}
+
+	//  Right tangent
+	if ( key_id < markers.get_markers_count() - 1 )
+	{
+		_add_point_marker(
+			control_point_id + 1,
+			_transform_curve_to_screen( marker.right_tangent ),
+			true,
+			marker.tangent_mode
+		);
+	}
+
+	_add_point_marker( 
+		control_point_id, 
+		_transform_curve_to_screen( marker.control ), 
+		false,
+		marker.tangent_mode
+	);
+}
+
 void CurveEditorWidget::_render_ui_interpolation_modes()
 {
 	const float margin = 16.0f;
@@ -1068,59 +1327,47 @@ void CurveEditorWidget::_render_ui_interpolation_modes()
 
 void CurveEditorWidget::_render_grid()
 {
+	TRACE_SCOPE( "CurveEditorWidget::_render_grid" );
+
 	//  Find in-frame curve coordinates extrems, these positions
 	//  will be used to draw our grid in a performant way where
 	//  only visible grid lines will be rendered
-	Vector2 curve_top_left = _transform_screen_to_curve( { 
-		_viewport_frame.x, 
-		_viewport_frame.y 
-	} );
-	Vector2 curve_bottom_right = _transform_screen_to_curve( { 
-		_viewport_frame.x + _viewport_frame.width, 
-		_viewport_frame.y + _viewport_frame.height 
-	} );
-
-	//  Grid-snap positions 
-	//  (ceiling instead of rounding fixes sudden lines appearing)
-	curve_top_left = _transform_ceiled_grid_snap( curve_top_left );
-	curve_bottom_right = _transform_ceiled_grid_snap( curve_bottom_right );
+	const CurveExtrems visible_extrems = _get_visible_curve_extrems( 0.0f );
 
 	//  Draw vertical lines
+	const CurveGridLines vertical_lines = _grid.find_lines_in( 
+		visible_extrems.min_x, visible_extrems.max_x );
 	for ( 
-		float x = curve_top_left.x; 
-		      x < curve_bottom_right.x; 
-		      x += _grid_gap 
+		int64_t i = vertical_lines.first_index; 
+		        i <= vertical_lines.last_index; 
+		        i++ 
 	)
 	{
-		_render_grid_line( x, false );
+		_render_grid_line( i, false );
 	}
 
 	//  Draw horizontal lines
+	const CurveGridLines horizontal_lines = _grid.find_lines_in( 
+		visible_extrems.min_y, visible_extrems.max_y );
 	for ( 
-		float y = curve_bottom_right.y; 
-		      y < curve_top_left.y; 
-		      y += _grid_gap 
+		int64_t i = horizontal_lines.first_index; 
+		        i <= horizontal_lines.last_index; 
+		        i++ 
 	)
 	{
-		_render_grid_line( y, true );
+		_render_grid_line( i, true );
 	}
 }
 
-void CurveEditorWidget::_render_grid_line( float value, bool is_horizontal )
+void CurveEditorWidget::_render_grid_line( int64_t index, bool is_horizontal )
 {
+	const float value = _grid.get_line_value( index );
 	float screen_value = is_horizontal 
 		? _transform_curve_to_screen_y( value )
 		: _transform_curve_to_screen_x( value );
 
-	//  Fix some weird cases where zero was negative
-	if ( Utils::near_zero( value ) )
-	{
-		value = 0.0f;
-	}
-
 	//  Determine style depending on line key
-	bool is_large_line = Utils::near_zero( fmodf( 
-		value, settings::GRID_LARGE_COUNT * _grid_gap ) );
+	bool is_large_line = _grid.is_large_line( index );
 	float font_size = is_large_line 
 		? settings::GRID_LARGE_GRID_FONT_SIZE 
 		: settings::GRID_SMALL_GRID_FONT_SIZE;
@@ -1128,10 +1375,9 @@ void CurveEditorWidget::_render_grid_line( float value, bool is_horizontal )
 		? settings::GRID_LARGE_LINE_THICKNESS 
 		: settings::GRID_SMALL_LINE_THICKNESS;
 
-	//  Compute text & its size
-	const char* text = TextFormat( _grid_label_format.c_str(), value );
-	Vector2 text_size = MeasureTextEx( 
-		GetFontDefault(), text, font_size, settings::GRID_FONT_SPACING );
+	//  Get cached text & its size
+	const CurveGridLabel& label = _grid.get_label( index, font_size );
+	const Vector2& text_size = label.size;
 
 	//  Determine positions
 	Vector2 text_pos {};
@@ -1173,7 +1419,7 @@ void CurveEditorWidget::_render_grid_line( float value, bool is_horizontal )
 	//  Draw label
 	DrawTextEx( 
 		GetFontDefault(),
-		text, 
+		label.text.c_str(), 
 		text_pos,
 		font_size,
 		settings::GRID_FONT_SPACING,
@@ -1181,10 +1427,13 @@ void CurveEditorWidget::_render_grid_line( float value, bool is_horizontal )
 	);
 }
 
-void CurveEditorWidget::_render_point( int point_id, const Vector2& pos )
+void CurveEditorWidget::_add_point_marker( 
+	int point_id, 
+	const Vector2& pos,
+	bool is_tangent,
+	TangentMode tangent_mode
+)
 {
-	const auto& selected_layer = _application->get_selected_curve_layer();
-	bool is_tangent = !selected_layer->curve.is_control_point_id( point_id );
 	bool is_selected = point_id == _selected_point_id;
 	bool is_hovered = point_id == _hovered_point_id || is_selected;
 
@@ -1201,69 +1450,102 @@ void CurveEditorWidget::_render_point( int point_id, const Vector2& pos )
 			: settings::POINT_COLOR;
 	}
 
-	//  Draw point
-	if ( is_tangent )
+	const float size = settings::POINT_SIZE;
+
+	//  Broken tangents are squares, other points are circles
+	if ( is_tangent && tangent_mode == TangentMode::Broken )
+	{
+		_marker_batch.add_square( pos, size, color );
+
+		if ( is_selected )
+		{
+			_marker_batch.add_square_lines( 
+				pos, 
+				size + settings::POINT_SELECTED_OFFSET_SIZE + 1.0f, 
+				1.0f, 
+				settings::POINT_SELECTED_COLOR 
+			);
+		}
+	}
+	else
 	{
-		int key_id = selected_layer->curve.point_to_key_id( point_id );
-		TangentMode mode = selected_layer->curve.get_tangent_mode( key_id );
+		_marker_batch.add_circle( pos, size * 0.5f, color );
+
+		if ( is_selected )
+		{
+			_marker_batch.add_ring( 
+				pos, 
+				size * 0.5f + settings::POINT_SELECTED_OFFSET_SIZE, 
+				1.0f, 
+				settings::POINT_SELECTED_COLOR 
+			);
+		}
+	}
+}
 
-		//  Draw point depending on mode
+void CurveEditorWidget::_render_selected_point_texts( 
+	const Curve& curve,
+	const CurveKeyMarkers& markers 
+)
+{
+	const int key_id = curve.point_to_key_id( _selected_point_id );
+	const CurveKeyMarker& marker = markers.get_marker( key_id );
+
+	//  Local point for its coordinates, global marker for its position
+	const Point& point = curve.get_point( _selected_point_id );
+	const int point_offset = _selected_point_id 
+		- curve.key_to_point_id( key_id );
+	const Point& marker_point = point_offset == 1 ? marker.right_tangent
+		: point_offset == 2 ? marker.left_tangent
+		: marker.control;
+	const Vector2 pos = _transform_curve_to_screen( marker_point );
+
+	//  Draw tangent mode name
+	if ( !curve.is_control_point_id( _selected_point_id ) )
+	{
 		const char* mode_name = "N/A";
-		switch ( mode )
+		switch ( marker.tangent_mode )
 		{
 			case TangentMode::Mirrored:
-				_render_circle_point( pos, color, is_selected );
 				mode_name = "mirrored";
 				break;
 				
 			case TangentMode::Aligned:
-				_render_circle_point( pos, color, is_selected );
 				mode_name = "aligned";
 				break;
 
 			case TangentMode::Broken:
-				_render_square_point( pos, color, is_selected );
 				mode_name = "broken";
 				break;
 		}
 
-		//  Draw mode name
-		if ( is_selected )
-		{
-			float font_size = 20.0f;
-			float spacing = 2.0f;
-
-			//  measure text size
-			Vector2 size = MeasureTextEx( 
-				GetFontDefault(), 
-				mode_name,
-				font_size,
-				spacing
-			);
+		float font_size = 20.0f;
+		float spacing = 2.0f;
 
-			//  draw text
-			DrawTextEx( 
-				GetFontDefault(),
-				mode_name,
-				Vector2 {
-					pos.x - size.x * 0.5f,
-					pos.y - size.y * 1.5f,
-				},
-				font_size,
-				spacing,
-				settings::TANGENT_COLOR
-			);
-		}
-	}
-	else
-	{
-		_render_circle_point( pos, color, is_selected );
+		//  measure text size
+		Vector2 size = MeasureTextEx( 
+			GetFontDefault(), 
+			mode_name,
+			font_size,
+			spacing
+		);
+
+		//  draw text
+		DrawTextEx( 
+			GetFontDefault(),
+			mode_name,
+			Vector2 {
+				pos.x - size.x * 0.5f,
+				pos.y - size.y * 1.5f,
+			},
+			font_size,
+			spacing,
+			settings::TANGENT_COLOR
+		);
 	}
 
-	if ( is_selected && !_is_quick_evaluating )
+	if ( !_is_quick_evaluating )
 	{
-		const Point& point = selected_layer->curve.get_point( point_id );
-
 		//  Draw coordinates
 		DrawTextEx( 
 			GetFontDefault(),
@@ -1278,59 +1560,3 @@ void CurveEditorWidget::_render_point( int point_id, const Vector2& pos )
 		);
 	}
 }
-
-void CurveEditorWidget::_render_circle_point( 
-	const Vector2& pos, 
-	const Color& color,
-	bool is_selected
-)
-{
-	//  Draw point
-	DrawCircleV( 
-		pos, 
-		settings::POINT_SIZE * 0.5f, 
-		color
-	);
-
-	//  Draw selected
-	if ( is_selected )
-	{
-		DrawCircleLinesV( 
-			pos, 
-			settings::POINT_SIZE * 0.5f + settings::POINT_SELECTED_OFFSET_SIZE, 
-			settings::POINT_SELECTED_COLOR 
-		);
-	}
-}
-
-void CurveEditorWidget::_render_square_point( 
-	const Vector2& pos, 
-	const Color& color,
-	bool is_selected
-)
-{
-	int size = (int)settings::POINT_SIZE;
-
-	//  Draw point
-	DrawRectangle( 
-		(int)pos.x - size / 2,
-		(int)pos.y - size / 2,
-		size,
-		size,
-		color
-	);
-
-	//  Draw selected
-	if ( is_selected )
-	{
-		size += (int)( settings::POINT_SELECTED_OFFSET_SIZE + 1.0f );
-
-		DrawRectangleLines(
-			(int)pos.x - size / 2,
-			(int)pos.y - size / 2,
-			size,
-			size,
-			settings::POINT_SELECTED_COLOR
-		);
-	}
-}
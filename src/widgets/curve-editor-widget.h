@@ -3,7 +3,11 @@
 
 #include <src/application.fwd.h>
 #include <src/curve-layer.h>
+#include <src/curve-layers-texture.h>
+#include <src/curve-grid.h>
+#include <src/marker-batch.h>
 #include <src/curve-interpolate-mode.h>
+#include <src/screen-point-grid.h>
 
 namespace curve_editor_x
 {
@@ -19,6 +23,7 @@ namespace curve_editor_x
 
 		void update( float dt ) override;
 		void render() override;
+		const char* get_name() const override { return "CurveEditorWidget"; }
 
 		void invalidate_layout() override;
 
@@ -26,46 +31,93 @@ namespace curve_editor_x
 
 	private:
 		void _invalidate_grid();
+		/*
+		 * Returns whether the curve-space bounds overlap the viewport.
+		 */
+		bool _is_extrems_visible( const CurveExtrems& extrems ) const;
 
 		bool _is_double_clicking( bool should_consume );
 
 		void _add_key_at_position( bool is_alt_down );
 
+		void _update_hover_grid( const ref<CurveLayer>& layer );
+
 		float _transform_curve_to_screen_x( float x ) const;
 		float _transform_curve_to_screen_y( float y ) const;
 		Vector2 _transform_curve_to_screen( const Point& point ) const;
 		Vector2 _transform_screen_to_curve( const Vector2& pos ) const;
+		/*
+		 * Returns the pixels per curve unit on each axis.
+		 */
+		Point _get_curve_to_screen_scale() const;
+		/*
+		 * Returns the curve-space bounds of the viewport frame, 
+		 * extended by a padding in pixels.
+		 */
+		CurveExtrems _get_visible_curve_extrems( float padding ) const;
 		Vector2 _transform_rounded_grid_snap( const Vector2& pos ) const;
-		Vector2 _transform_ceiled_grid_snap( const Vector2& pos ) const;
 
 		void _render_title_text();
 
 		void _render_curve_screen();
 		void _render_invalid_curve_screen();
 
-		void _render_curve_by_distance( const ref<CurveLayer>& layer );
-		void _render_curve_by_time( const ref<CurveLayer>& layer );
-		void _render_curve_by_bezier( const ref<CurveLayer>& layer );
+		/*
+		 * Re-draws the un-selected layers into their texture if any of
+		 * them or the view changed.
+		 */
+		void _update_layers_texture();
+		void _render_curve_layer( const ref<CurveLayer>& layer );
+		/*
+		 * Draws the retained mesh of the layer, rebuilding it if 
+		 * out-of-date. Returns false if the curve is too large to be
+		 * retained.
+		 */
+		bool _render_curve_layer_mesh(
+			const ref<CurveLayer>& layer,
+			const Color& color
+		);
+		void _build_curve_stroke(
+			const ref<CurveLayer>& layer,
+			PolylineStroke* stroke
+		);
+		void _build_curve_stroke_by_time( 
+			const ref<CurveLayer>& layer,
+			PolylineStroke* stroke
+		);
+		/*
+		 * Strokes the projected polyline of '_screen_points', then
+		 * clears it.
+		 */
+		void _add_screen_polyline_to_stroke( PolylineStroke* stroke );
 		void _render_curve_points( const ref<CurveLayer>& layer );
+		void _add_curve_key_tangent_lines( 
+			const CurveKeyMarkers& markers, 
+			int key_id 
+		);
+		void _add_curve_key_points( 
+			const Curve& curve,
+			const CurveKeyMarkers& markers, 
+			int key_id 
+		);
 
 		void _render_ui_interpolation_modes();
 
 		void _render_grid();
 		void _render_grid_line( 
-			float value,
+			int64_t index,
 			bool is_horizontal
 		);
 
-		void _render_point( int point_id, const Vector2& pos );
-		void _render_circle_point( 
-			const Vector2& pos, 
-			const Color& color,
-			bool is_selected
+		void _add_point_marker( 
+			int point_id, 
+			const Vector2& pos,
+			bool is_tangent,
+			TangentMode tangent_mode
 		);
-		void _render_square_point( 
-			const Vector2& pos, 
-			const Color& color,
-			bool is_selected
+		void _render_selected_point_texts( 
+			const Curve& curve,
+			const CurveKeyMarkers& markers 
 		);
 
 	private:
@@ -74,6 +126,8 @@ namespace curve_editor_x
 		float _zoom = 1.0f;
 		Rectangle _viewport {};
 		Rectangle _viewport_frame {};
+		//  Incremented each time the viewport transform changes
+		int _view_revision = 0;
 
 		CurveExtrems _curve_extrems {};
 		CurveInterpolateMode _curve_interpolate_mode 
@@ -86,18 +140,38 @@ namespace curve_editor_x
 		bool _is_dragging_point = false;
 		bool _is_showing_points = true;
 
-		float _grid_gap = 1.0f;
-		std::string _grid_label_format;
+		CurveGrid _grid {};
 
 		Vector2 _quick_evaluation_pos {};
 
 		double _last_click_time = 0.0;
 
 		int _hovered_point_id = -1;
+
+		//  Screen-space points of the selected curve for hovering
+		ScreenPointGrid _hover_grid {};
+		std::weak_ptr<CurveLayer> _hover_grid_layer {};
+		int _hover_grid_layer_revision = -1;
+		int _hover_grid_view_revision = -1;
 		int _selected_point_id = -1;
 
 		float _curve_thickness = 1.0f;
 
+		//  Segments of the layer being rendered inside the viewport
+		std::vector<int> _visible_segment_ids {};
+		//  Keys of the selected layer inside the viewport
+		std::vector<int> _visible_key_ids {};
+		//  Points & tangents of the visible keys
+		MarkerBatch _marker_batch {};
+		//  Screen-space points of the polyline being stroked
+		std::vector<Vector2> _screen_points {};
+		//  Stroke of a whole curve before its upload as a mesh
+		PolylineStroke _mesh_stroke {};
+
+		//  Un-selected layers drawn under the selected one
+		CurveLayersTexture _layers_texture {};
+		std::vector<CurveLayerSignature> _layer_signatures {};
+
 		bool _is_quick_evaluating = false;
 	};
 }
\ No newline at end of file
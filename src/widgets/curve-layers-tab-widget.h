@@ -15,6 +15,7 @@ namespace curve_editor_x
 
 		void update( float dt ) override;
 		void render() override;
+		const char* get_name() const override { return "CurveLayersTabWidget"; }
 
 		void invalidate_layout() override;
 
@@ -23,6 +23,21 @@ namespace curve_editor_x
 
 		virtual void invalidate_layout() {};
 
+		/*
+		 * Returns the name of the widget's class, as a literal.
+		 */
+		virtual const char* get_name() const { return "Widget"; }
+
+		/*
+		 * Requests the widget to be rendered on the next frame.
+		 */
+		void mark_dirty() { _is_dirty = true; }
+		void clear_dirty() { _is_dirty = false; }
+		/*
+		 * Returns whether the widget changed since its last render.
+		 */
+		bool is_dirty() const { return _is_dirty; }
+
 		template <typename T>
 		ref<T> cast()
 		{
@@ -32,5 +47,8 @@ namespace curve_editor_x
 	public:
 		Rectangle frame { 0.0f, 0.0f, 100.0f, 100.0f };
 		Color color = WHITE;
+
+	private:
+		bool _is_dirty = true;
 	};
 }
\ No newline at end of file
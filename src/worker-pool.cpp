@@ -0,0 +1,71 @@
+#include "worker-pool.h"
+
+#include <src/trace.h>
+
+using namespace curve_editor_x;
+
+WorkerPool::WorkerPool( int threads_count )
+{
+	if ( threads_count <= 0 )
+	{
+		threads_count = (int)std::thread::hardware_concurrency() - 1;
+		if ( threads_count < 1 ) threads_count = 1;
+	}
+
+	_threads.reserve( threads_count );
+	for ( int i = 0; i < threads_count; i++ )
+	{
+		_threads.emplace_back( &WorkerPool::_run_worker, this );
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_is_stopping = true;
+	}
+	_condition.notify_all();
+
+	for ( std::thread& thread : _threads )
+	{
+		thread.join();
+	}
+}
+
+void WorkerPool::submit( std::function<void()> job )
+{
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_jobs.push_back( std::move( job ) );
+	}
+	_condition.notify_one();
+}
+
+int WorkerPool::get_threads_count() const
+{
+	return (int)_threads.size();
+}
+
+void WorkerPool::_run_worker()
+{
+	while ( true )
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock( _mutex );
+			_condition.wait( lock, [this] { 
+				return _is_stopping || !_jobs.empty(); 
+			} );
+
+			//  Finish the queued jobs before stopping
+			if ( _jobs.empty() ) return;
+
+			job = std::move( _jobs.front() );
+			_jobs.pop_front();
+		}
+
+		TRACE_SCOPE( "WorkerPool::job" );
+		job();
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace curve_editor_x
+{
+	/*
+	 * Fixed set of threads running submitted jobs in order of
+	 * submission. Jobs mustn't call raylib, which is bound to the
+	 * main thread.
+	 *
+	 * Destroying the pool waits for the queued jobs to finish.
+	 */
+	class WorkerPool
+	{
+	public:
+		/*
+		 * Starts the threads, using one less than the hardware
+		 * threads if the count isn't positive, keeping a core for
+		 * the main thread.
+		 */
+		WorkerPool( int threads_count = 0 );
+		WorkerPool( const WorkerPool& ) = delete;
+		WorkerPool& operator=( const WorkerPool& ) = delete;
+		~WorkerPool();
+
+		void submit( std::function<void()> job );
+
+		int get_threads_count() const;
+
+	private:
+		void _run_worker();
+
+	private:
+		std::vector<std::thread> _threads {};
+
+		std::mutex _mutex {};
+		std::condition_variable _condition {};
+		std::deque<std::function<void()>> _jobs {};
+		bool _is_stopping = false;
+	};
+}
@@ -0,0 +1,59 @@
+#include <tests/test.h>
+
+#include <src/curve-baker.h>
+#include <src/settings.h>
+
+using namespace curve_editor_x;
+
+static Curve make_curve( float amplitude )
+{
+	Curve curve {};
+	curve.add_key( CurveKey(
+		Point { 0.0f, 0.0f }, Point { -0.5f, 0.0f }, Point { 0.5f, amplitude } ) );
+	curve.add_key( CurveKey(
+		Point { 2.0f, amplitude }, Point { -0.5f, 0.0f }, Point { 0.5f, 0.0f } ) );
+	curve.add_key( CurveKey(
+		Point { 4.0f, -amplitude }, Point { -1.0f, amplitude }, Point { 1.0f, -amplitude } ) );
+	return curve;
+}
+
+static void test_adaptive_float()
+{
+	const Curve curve = make_curve( 1.0f );
+	constexpr float MAX_ERROR = 1e-3f;
+
+	const BakedCurve baked_curve = CurveBaker::bake_adaptive( 
+		curve, MAX_ERROR, BakedCurvePrecision::Float );
+	const CurveBakeReport report = CurveBaker::measure( baked_curve, curve );
+
+	TEST_CHECK( report.samples_count >= curve.get_keys_count() );
+	TEST_CHECK( report.max_error <= MAX_ERROR * 1.5f );
+}
+
+static void test_adaptive_half()
+{
+	//  Large values, where halfs can't reach the asked error
+	const Curve curve = make_curve( 1000.0f );
+	constexpr float MAX_ERROR = 1e-3f;
+
+	const float half_precision = CurveBaker::get_half_precision( curve );
+	TEST_CHECK( half_precision > MAX_ERROR );
+
+	const BakedCurve baked_curve = CurveBaker::bake_adaptive( 
+		curve, MAX_ERROR, BakedCurvePrecision::Half );
+	const CurveBakeReport report = CurveBaker::measure( baked_curve, curve );
+
+	//  Not subdivided down to the maximum depth
+	const int max_samples_count = 
+		( curve.get_keys_count() - 1 ) * ( 1 << settings::BAKE_MAX_DEPTH );
+	TEST_CHECK( report.samples_count < max_samples_count / 16 );
+	TEST_CHECK( report.max_error <= half_precision * 2.0f );
+}
+
+int main()
+{
+	test_adaptive_float();
+	test_adaptive_half();
+
+	return TEST_RESULT();
+}
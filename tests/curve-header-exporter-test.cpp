@@ -0,0 +1,47 @@
+#include <tests/test.h>
+
+#include <src/curve-header-exporter.h>
+
+#include <string>
+
+using namespace curve_editor_x;
+
+static bool contains( const std::string& text, const std::string& pattern )
+{
+	return text.find( pattern ) != std::string::npos;
+}
+
+static void test_identifiers()
+{
+	//  Keywords & leading digits can't be identifiers
+	TEST_CHECK( CurveHeaderExporter::sanitize_identifier( "default" ) == "curve_default" );
+	TEST_CHECK( CurveHeaderExporter::sanitize_identifier( "int" ) == "curve_int" );
+	TEST_CHECK( CurveHeaderExporter::sanitize_identifier( "2d speed" ) == "curve_2d_speed" );
+	TEST_CHECK( CurveHeaderExporter::sanitize_identifier( "" ) == "curve_" );
+
+	//  No reserved double underscores
+	TEST_CHECK( CurveHeaderExporter::sanitize_identifier( "_a  b" ) == "curve_a_b" );
+}
+
+static void test_generate()
+{
+	Curve curve {};
+	curve.add_key( CurveKey( Point { 0.0f, 0.0f }, Point { -1.0f, 0.0f }, Point { 1.0f, 1.0f } ) );
+	curve.add_key( CurveKey( Point { 2.0f, 1.0f }, Point { -1.0f, 0.0f }, Point { 1.0f, 0.0f } ) );
+
+	CurveTimeEvaluator evaluator;
+	evaluator.rebuild( curve );
+
+	const std::string header = CurveHeaderExporter::generate( "default", evaluator );
+	TEST_CHECK( contains( header, "namespace curve_default\n" ) );
+	TEST_CHECK( contains( header, "constexpr int SEGMENTS_COUNT = 1;" ) );
+	TEST_CHECK( contains( header, "constexpr float evaluate_by_time( float time )" ) );
+}
+
+int main()
+{
+	test_identifiers();
+	test_generate();
+
+	return TEST_RESULT();
+}
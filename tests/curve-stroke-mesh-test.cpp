@@ -0,0 +1,148 @@
+#include <tests/test.h>
+
+#include <src/curve-stroke-mesh.h>
+#include <src/curve-tessellation.h>
+#include <src/polyline-stroke.h>
+#include <src/settings.h>
+
+#include <cmath>
+
+using namespace curve_editor_x;
+
+constexpr float THICKNESS = 2.0f;
+constexpr float MITER_LIMIT = 2.0f;
+constexpr float EPSILON = 1e-4f;
+
+static float get_distance( const Vector2& a, const Vector2& b )
+{
+	return sqrtf( ( a.x - b.x ) * ( a.x - b.x ) + ( a.y - b.y ) * ( a.y - b.y ) );
+}
+
+static bool has_vertex(
+	const std::vector<Vector2>& vertices,
+	const Vector2& pos
+)
+{
+	for ( const Vector2& vertex : vertices )
+	{
+		if ( get_distance( vertex, pos ) < EPSILON ) return true;
+	}
+	return false;
+}
+
+/*
+ * Returns whether all vertices are within the miter limit of the 
+ * polyline's points, ends & joins.
+ */
+static bool is_within_miter_limit(
+	const std::vector<Vector2>& vertices,
+	const Vector2* points,
+	int points_count
+)
+{
+	for ( const Vector2& vertex : vertices )
+	{
+		float min_distance = INFINITY;
+		for ( int i = 0; i < points_count; i++ )
+		{
+			min_distance = std::fmin( min_distance, get_distance( vertex, points[i] ) );
+		}
+
+		if ( min_distance > THICKNESS * 0.5f * MITER_LIMIT + EPSILON ) return false;
+	}
+	return true;
+}
+
+static void test_straight_polyline()
+{
+	const Vector2 points[] { { 0.0f, 0.0f }, { 5.0f, 0.0f }, { 10.0f, 0.0f } };
+
+	PolylineStroke stroke;
+	stroke.add_polyline( points, 3, THICKNESS, MITER_LIMIT );
+
+	//  A quad per line
+	const std::vector<Vector2>& vertices = stroke.get_vertices();
+	TEST_CHECK( vertices.size() == 2 * 6 );
+
+	//  Within the thickness, up to the ends
+	float min_x = points[2].x, max_x = points[0].x;
+	for ( const Vector2& vertex : vertices )
+	{
+		TEST_CHECK( fabsf( fabsf( vertex.y ) - THICKNESS * 0.5f ) < EPSILON );
+		min_x = std::fmin( min_x, vertex.x );
+		max_x = std::fmax( max_x, vertex.x );
+	}
+	TEST_CHECK( min_x == points[0].x && max_x == points[2].x );
+
+	stroke.clear();
+	TEST_CHECK( stroke.get_vertices().empty() );
+}
+
+static void test_duplicated_points()
+{
+	const Vector2 points[] { { 0.0f, 0.0f }, { 0.0f, 0.0f }, { 5.0f, 0.0f } };
+
+	PolylineStroke stroke;
+	stroke.add_polyline( points, 3, THICKNESS, MITER_LIMIT );
+	TEST_CHECK( stroke.get_vertices().size() == 6 );
+
+	//  Nothing to stroke without a direction
+	stroke.clear();
+	stroke.add_polyline( points, 2, THICKNESS, MITER_LIMIT );
+	TEST_CHECK( stroke.get_vertices().empty() );
+}
+
+static void test_joins()
+{
+	PolylineStroke stroke;
+
+	//  Right angle, mitered within the limit
+	const Vector2 corner[] { { 0.0f, 0.0f }, { 5.0f, 0.0f }, { 5.0f, 5.0f } };
+	stroke.add_polyline( corner, 3, THICKNESS, MITER_LIMIT );
+	TEST_CHECK( stroke.get_vertices().size() == 2 * 6 );
+	TEST_CHECK( has_vertex( stroke.get_vertices(), Vector2 { 6.0f, -1.0f } ) );
+	TEST_CHECK( has_vertex( stroke.get_vertices(), Vector2 { 4.0f, 1.0f } ) );
+
+	//  Sharp turn, beveled with an extra triangle
+	const Vector2 turn[] { { 0.0f, 0.0f }, { 5.0f, 0.0f }, { 0.0f, 0.5f } };
+	stroke.clear();
+	stroke.add_polyline( turn, 3, THICKNESS, MITER_LIMIT );
+	TEST_CHECK( stroke.get_vertices().size() == 2 * 6 + 3 );
+	TEST_CHECK( is_within_miter_limit( stroke.get_vertices(), turn, 3 ) );
+}
+
+static void test_mesh_scale()
+{
+	const float max_ratio = exp2f(
+		1.0f / (float)settings::CURVE_TESSELLATION_ZOOM_BUCKETS );
+
+	//  Zooming inside a bucket keeps the projection of the vertices
+	const Point scale { 100.0f, 3.0f };
+	const Point mesh_scale = CurveStrokeMesh::get_mesh_scale( scale );
+	const Point zoomed_mesh_scale = CurveStrokeMesh::get_mesh_scale(
+		Point { scale.x * 0.99f, scale.y * 0.99f } );
+	TEST_CHECK( mesh_scale.x == zoomed_mesh_scale.x );
+	TEST_CHECK( mesh_scale.y == zoomed_mesh_scale.y );
+	TEST_CHECK( mesh_scale.x == CurveTessellation::get_bucket_scale(
+		CurveTessellation::get_scale_bucket( scale.x ) ) );
+
+	//  Scaled down by at most the bucket's ratio when drawn
+	TEST_CHECK( mesh_scale.x >= scale.x && mesh_scale.x <= scale.x * max_ratio );
+	TEST_CHECK( mesh_scale.y >= scale.y && mesh_scale.y <= scale.y * max_ratio );
+
+	//  Past the clamped buckets, the exact scale is kept
+	const Point far_scale { 1e6f, 1e-6f };
+	const Point far_mesh_scale = CurveStrokeMesh::get_mesh_scale( far_scale );
+	TEST_CHECK( far_mesh_scale.x == far_scale.x );
+	TEST_CHECK( far_mesh_scale.y == far_scale.y );
+}
+
+int main()
+{
+	test_straight_polyline();
+	test_duplicated_points();
+	test_joins();
+	test_mesh_scale();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,102 @@
+#include <tests/test.h>
+
+#include <src/curve-tessellation.h>
+
+using namespace curve_editor_x;
+
+static Curve make_curve( int keys_count )
+{
+	Curve curve {};
+	for ( int i = 0; i < keys_count; i++ )
+	{
+		curve.add_key( CurveKey(
+			Point { (float)i, i % 2 == 0 ? 0.0f : 1.0f },
+			Point { -0.5f, 0.5f },
+			Point { 0.5f, -0.5f }
+		) );
+	}
+	return curve;
+}
+
+static bool is_same( const Point& a, const Point& b )
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+static void test_segments_ends()
+{
+	const Curve curve = make_curve( 5 );
+	const Point scale { 100.0f, 100.0f };
+
+	CurveTessellation tessellation;
+	tessellation.update( curve, scale );
+	TEST_CHECK( !tessellation.is_dirty( scale ) );
+	TEST_CHECK( tessellation.get_segments_count() == 4 );
+
+	int points_count = 0;
+	for ( int i = 0; i < tessellation.get_segments_count(); i++ )
+	{
+		const std::vector<Point>& points = tessellation.get_segment_points( curve, i );
+		TEST_CHECK( points.size() >= 2 );
+		TEST_CHECK( is_same( points.front(), curve.get_key( i ).control ) );
+		TEST_CHECK( is_same( points.back(), curve.get_key( i + 1 ).control ) );
+
+		points_count += (int)points.size();
+	}
+	TEST_CHECK( tessellation.pop_tessellated_points_count() == points_count );
+}
+
+static void test_dirty_segments()
+{
+	const Curve curve = make_curve( 100 );
+	const Point scale { 100.0f, 100.0f };
+
+	CurveTessellation tessellation;
+	tessellation.update( curve, scale );
+
+	//  Nothing is tessellated until requested
+	TEST_CHECK( tessellation.pop_tessellated_points_count() == 0 );
+	for ( int i = 0; i < tessellation.get_segments_count(); i++ )
+	{
+		tessellation.get_segment_points( curve, i );
+	}
+	TEST_CHECK( tessellation.pop_tessellated_points_count() > 0 );
+
+	//  Only the two segments around the key are re-tessellated
+	const int key_id = 50;
+	tessellation.invalidate_key( key_id );
+	TEST_CHECK( tessellation.is_dirty( scale ) );
+	tessellation.update( curve, scale );
+	for ( int i = 0; i < tessellation.get_segments_count(); i++ )
+	{
+		tessellation.get_segment_points( curve, i );
+	}
+	TEST_CHECK( tessellation.pop_tessellated_points_count() == 
+		(int)tessellation.get_segment_points( curve, key_id - 1 ).size()
+	  + (int)tessellation.get_segment_points( curve, key_id ).size() );
+
+	//  Nothing to re-tessellate
+	tessellation.get_segment_points( curve, 0 );
+	TEST_CHECK( tessellation.pop_tessellated_points_count() == 0 );
+}
+
+static void test_scale_clamp()
+{
+	const Curve curve = make_curve( 3 );
+
+	CurveTessellation tessellation;
+	tessellation.update( curve, Point { 1e6f, 1e6f } );
+
+	//  Zooming further in doesn't subdivide further
+	TEST_CHECK( !tessellation.is_dirty( Point { 1e9f, 1e9f } ) );
+	TEST_CHECK( tessellation.is_dirty( Point { 1.0f, 1.0f } ) );
+}
+
+int main()
+{
+	test_segments_ends();
+	test_dirty_segments();
+	test_scale_clamp();
+
+	return TEST_RESULT();
+}
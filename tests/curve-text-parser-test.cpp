@@ -0,0 +1,122 @@
+#include <tests/test.h>
+
+#include <src/curve-text-parser.h>
+
+#include <curve-x/curve-serializer.h>
+
+#include <cmath>
+#include <string>
+
+using namespace curve_editor_x;
+
+static bool is_near( const Point& a, const Point& b )
+{
+	constexpr float TOLERANCE = 1e-4f;
+	return fabsf( a.x - b.x ) <= TOLERANCE && fabsf( a.y - b.y ) <= TOLERANCE;
+}
+
+static bool is_same( const Point& a, const Point& b )
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+static Curve make_curve()
+{
+	Curve curve {};
+	curve.add_key( CurveKey(
+		Point { 0.0f, 0.0f }, Point { -0.5f, 0.0f }, Point { 0.5f, 0.25f },
+		TangentMode::Mirrored ) );
+	curve.add_key( CurveKey(
+		Point { 1.25f, 3.5f }, Point { -0.1f, -0.2f }, Point { 0.75f, 1.5f },
+		TangentMode::Aligned ) );
+	curve.add_key( CurveKey(
+		Point { 4.0f, -1.0f / 3.0f }, Point { -2.0f, 1e-3f }, Point { 0.125f, -8.0f },
+		TangentMode::Broken ) );
+	return curve;
+}
+
+static void test_round_trip()
+{
+	const Curve curve = make_curve();
+
+	CurveSerializer serializer;
+	const std::string data = serializer.serialize( curve );
+	const Curve unserialized_curve = serializer.unserialize( data );
+
+	Curve parsed_curve {};
+	CurveTextParser parser;
+	TEST_CHECK( parser.parse( data, &parsed_curve ) );
+	TEST_CHECK( parsed_curve.get_keys_count() == curve.get_keys_count() );
+	TEST_CHECK( unserialized_curve.get_keys_count() == curve.get_keys_count() );
+	if ( parsed_curve.get_keys_count() != curve.get_keys_count()
+	  || unserialized_curve.get_keys_count() != curve.get_keys_count() ) return;
+
+	for ( int i = 0; i < curve.get_keys_count(); i++ )
+	{
+		const CurveKey& key = curve.get_key( i );
+		const CurveKey& parsed_key = parsed_curve.get_key( i );
+		const CurveKey& unserialized_key = unserialized_curve.get_key( i );
+
+		//  Same keys as the serializer's, whatever its precision
+		TEST_CHECK( is_same( parsed_key.control, unserialized_key.control ) );
+		TEST_CHECK( is_same( parsed_key.left_tangent, unserialized_key.left_tangent ) );
+		TEST_CHECK( is_same( parsed_key.right_tangent, unserialized_key.right_tangent ) );
+
+		TEST_CHECK( is_near( parsed_key.control, key.control ) );
+		TEST_CHECK( is_near( parsed_key.left_tangent, key.left_tangent ) );
+		TEST_CHECK( is_near( parsed_key.right_tangent, key.right_tangent ) );
+		TEST_CHECK( parsed_curve.get_tangent_mode( i ) == curve.get_tangent_mode( i ) );
+	}
+
+	TEST_CHECK( CurveTextParser::is_serializer_compatible() );
+}
+
+static void test_chunks()
+{
+	CurveSerializer serializer;
+	const std::string data = serializer.serialize( make_curve() );
+
+	Curve curve {};
+	CurveTextParser parser;
+	TEST_CHECK( parser.parse( data, &curve ) );
+
+	//  Every line split across chunks
+	Curve chunked_curve {};
+	parser.begin();
+	for ( char c : data )
+	{
+		TEST_CHECK( parser.feed( std::string_view( &c, 1 ) ) );
+	}
+	TEST_CHECK( parser.end( &chunked_curve ) );
+
+	TEST_CHECK( chunked_curve.get_keys_count() == curve.get_keys_count() );
+	for ( int i = 0; i < curve.get_keys_count() && i < chunked_curve.get_keys_count(); i++ )
+	{
+		TEST_CHECK( is_same( chunked_curve.get_key( i ).control, curve.get_key( i ).control ) );
+	}
+}
+
+static void test_errors()
+{
+	Curve curve {};
+	CurveTextParser parser;
+
+	TEST_CHECK( !parser.parse( "", &curve ) );
+	TEST_CHECK( parser.get_error().line == 1 );
+
+	TEST_CHECK( !parser.parse( "version:1\n0,0,0,0,0,0,0\n0,x,0,0,0,0,0\n", &curve ) );
+	TEST_CHECK( parser.get_error().line == 3 );
+	TEST_CHECK( parser.get_error().column == 3 );
+
+	TEST_CHECK( !parser.parse( "version:1\n0,0,0,0,0,0,9\n", &curve ) );
+	TEST_CHECK( parser.get_error().line == 2 );
+}
+
+int main()
+{
+	test_round_trip();
+	test_chunks();
+	test_errors();
+
+	return TEST_RESULT();
+}
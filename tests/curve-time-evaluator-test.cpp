@@ -0,0 +1,86 @@
+#include <tests/test.h>
+
+#include <src/curve-time-evaluator.h>
+
+#include <cmath>
+
+using namespace curve_editor_x;
+
+static bool is_near( float a, float b )
+{
+	constexpr float TOLERANCE = 1e-4f;
+	return fabsf( a - b ) <= TOLERANCE * std::fmax( 1.0f, fabsf( b ) );
+}
+
+static Curve make_curve()
+{
+	//  Tangents reaching far on the X-axis, which time-evaluation ignores
+	Curve curve {};
+	curve.add_key( CurveKey(
+		Point { 0.0f, 0.0f }, Point { -1.0f, 0.0f }, Point { 2.5f, 1.0f } ) );
+	curve.add_key( CurveKey(
+		Point { 1.0f, 2.0f }, Point { -0.9f, -0.5f }, Point { 0.1f, 3.0f },
+		TangentMode::Broken ) );
+	curve.add_key( CurveKey(
+		Point { 4.0f, -1.0f }, Point { -3.0f, 0.0f }, Point { 3.0f, 0.0f } ) );
+	curve.add_key( CurveKey(
+		Point { 4.5f, 0.5f }, Point { -0.25f, 0.25f }, Point { 0.25f, -0.25f } ) );
+	return curve;
+}
+
+static void check_matches_library( const Curve& curve, const CurveTimeEvaluator& evaluator )
+{
+	constexpr int SAMPLES_COUNT = 1000;
+	constexpr float MIN_TIME = -1.0f;
+	constexpr float MAX_TIME = 5.5f;
+
+	for ( int i = 0; i <= SAMPLES_COUNT; i++ )
+	{
+		const float time = MIN_TIME + ( MAX_TIME - MIN_TIME ) * (float)i / (float)SAMPLES_COUNT;
+		TEST_CHECK( is_near( evaluator.evaluate_by_time( time ), curve.evaluate_by_time( time ) ) );
+	}
+
+	//  Exactly on the keys
+	for ( int i = 0; i < curve.get_keys_count(); i++ )
+	{
+		const float time = curve.get_key( i ).control.x;
+		TEST_CHECK( is_near( evaluator.evaluate_by_time( time ), curve.evaluate_by_time( time ) ) );
+	}
+}
+
+static void test_rebuild()
+{
+	const Curve curve = make_curve();
+
+	CurveTimeEvaluator evaluator;
+	evaluator.rebuild( curve );
+	TEST_CHECK( evaluator.get_segments_count() == curve.get_keys_count() - 1 );
+
+	check_matches_library( curve, evaluator );
+}
+
+static void test_update()
+{
+	Curve curve = make_curve();
+
+	CurveTimeEvaluator evaluator;
+	evaluator.rebuild( curve );
+
+	//  Move a key, only its segments being recomputed
+	const int key_id = 2;
+	curve.set_point( curve.key_to_point_id( key_id ), Point { 3.0f, 1.5f } );
+	evaluator.invalidate_key( key_id );
+	TEST_CHECK( evaluator.is_dirty() );
+	evaluator.update( curve );
+	TEST_CHECK( !evaluator.is_dirty() );
+
+	check_matches_library( curve, evaluator );
+}
+
+int main()
+{
+	test_rebuild();
+	test_update();
+
+	return TEST_RESULT();
+}
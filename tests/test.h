@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+
+/*
+ * Minimal checks for the headless tests: each test is an executable
+ * returning the number of failed checks, run by CTest.
+ */
+namespace curve_editor_x::test
+{
+	inline int failures_count = 0;
+}
+
+#define TEST_CHECK( condition ) \
+	do \
+	{ \
+		if ( !( condition ) ) \
+		{ \
+			fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+			curve_editor_x::test::failures_count++; \
+		} \
+	} while ( false )
+
+#define TEST_RESULT() ( curve_editor_x::test::failures_count == 0 ? 0 : 1 )